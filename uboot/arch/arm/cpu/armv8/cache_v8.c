@@ -250,7 +250,8 @@ static void add_map(struct mm_region *map)
 			blocksize = 1ULL << level2shift(level);
 			debug("Checking if pte fits for virt=%llx size=%llx blocksize=%llx\n",
 			      virt, size, blocksize);
-			if (size >= blocksize && !(virt & (blocksize - 1))) {
+			if (size >= blocksize &&
+			    !((virt | phys) & (blocksize - 1))) {
 				/* Page fits, create block PTE */
 				debug("Setting PTE %p to block virt=%llx\n",
 				      pte, virt);
@@ -303,6 +304,7 @@ static int count_required_pts(u64 addr, int level, u64 maxaddr)
 		struct mm_region *map = &mem_map[i];
 		u64 start = map->virt;
 		u64 end = start + map->size;
+		u64 offset = map->phys - map->virt;
 
 		/* Check if the PTE would overlap with the map */
 		if (max(addr, start) <= min(levelend, end)) {
@@ -310,7 +312,8 @@ static int count_required_pts(u64 addr, int level, u64 maxaddr)
 			end = min(levelend, end);
 
 			/* We need a sub-pt for this level */
-			if ((start & levelmask) || (end & levelmask)) {
+			if ((start & levelmask) || (end & levelmask) ||
+			    (offset & levelmask)) {
 				pte_type = PTE_LEVEL;
 				break;
 			}
@@ -531,36 +534,69 @@ int dcache_status(void)
 	return (get_sctlr() & CR_C) != 0;
 }
 
-u64 *__weak arch_get_page_table(void) {
-	puts("No page table offset defined\n");
+static void count_blocks(u64 *table, int level, ulong *counts)
+{
+	u64 *pte;
 
-	return NULL;
+	for (pte = table; pte < table + MAX_PTE_ENTRIES; pte++) {
+		if (level < 3 && pte_type(pte) == PTE_TYPE_TABLE)
+			count_blocks((u64 *)(*pte & 0x0000fffffffff000ULL),
+				     level + 1, counts);
+		else if (pte_type(pte) == (level < 3 ? PTE_TYPE_BLOCK :
+					   PTE_TYPE_PAGE))
+			counts[level]++;
+	}
 }
 
-static bool is_aligned(u64 addr, u64 size, u64 align)
+void mmu_count_blocks(ulong counts[4])
 {
-	return !(addr & (align - 1)) && !(size & (align - 1));
+	u64 va_bits;
+
+	memset(counts, '\0', 4 * sizeof(*counts));
+	if (!gd->arch.tlb_fillptr)
+		return;
+
+	get_tcr(NULL, &va_bits);
+	count_blocks((u64 *)gd->arch.tlb_addr, va_bits < 39 ? 1 : 0, counts);
 }
 
-/* Use flag to indicate if attrs has more than d-cache attributes */
+u64 *__weak arch_get_page_table(void) {
+	puts("No page table offset defined\n");
+
+	return NULL;
+}
+
+/*
+ * Use flag to indicate if attrs has more than d-cache attributes. Returns the
+ * number of bytes handled at this level, or 0 to go on to the next level.
+ */
 static u64 set_one_region(u64 start, u64 size, u64 attrs, bool flag, int level)
 {
 	int levelshift = level2shift(level);
 	u64 levelsize = 1ULL << levelshift;
 	u64 *pte = find_pte(start, level);
+	u64 mask = flag ? PMD_ATTRMASK : PMD_ATTRINDX_MASK;
+	u64 left = levelsize - (start & (levelsize - 1));
+
+	/* A table is already split, so its entries are handled one by one */
+	if (level < 3 && pte_type(pte) == PTE_TYPE_TABLE)
+		return 0;
+
+	/* Keep a block which has the attributes already, rather than split it */
+	if ((*pte & mask) == (attrs & mask) &&
+	    (flag || (*pte & PTE_TYPE_VALID))) {
+		debug("Keep attrs=%llx pte=%p level=%d\n", attrs, pte, level);
+
+		return min(left, size);
+	}
 
 	/* Can we can just modify the current level block PTE? */
-	if (is_aligned(start, size, levelsize)) {
-		if (flag) {
-			*pte &= ~PMD_ATTRMASK;
-			*pte |= attrs & PMD_ATTRMASK;
-		} else {
-			*pte &= ~PMD_ATTRINDX_MASK;
-			*pte |= attrs & PMD_ATTRINDX_MASK;
-		}
+	if (left == levelsize && (size >= levelsize || level == 3)) {
+		*pte &= ~mask;
+		*pte |= attrs & mask;
 		debug("Set attrs=%llx pte=%p level=%d\n", attrs, pte, level);
 
-		return levelsize;
+		return min(levelsize, size);
 	}
 
 	/* Unaligned or doesn't fit, maybe split block into table */
@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Run 'mtest -p' on all CPUs, starting them through PSCI
+ *
+ * Each CPU enters memtest_secondary_entry with the MMU off. It takes the MMU
+ * tables and vectors of the boot CPU, so that it runs its function with the
+ * caches on, then turns itself off again.
+ */
+
+#include <common.h>
+#include <cpu_func.h>
+#include <malloc.h>
+#include <memtest.h>
+#include <time.h>
+#include <watchdog.h>
+#include <asm/cache.h>
+#include <asm/global_data.h>
+#include <asm/io.h>
+#include <asm/psci.h>
+#include <asm/ptrace.h>
+#include <asm/system.h>
+#include <dm/ofnode.h>
+#include <linux/compiler.h>
+#include <linux/sizes.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define MEMTEST_MAX_CPUS	8
+#define MEMTEST_STACK_SIZE	SZ_16K
+#define MPIDR_HWID_MASK		0xff00ffffffUL
+
+/* Time allowed for a CPU to turn off after running its function */
+#define MEMTEST_OFF_TIMEOUT_MS	100
+
+/**
+ * struct memtest_cpu - state for starting a CPU
+ *
+ * The fields up to @vbar are read by memtest_secondary_entry, with the MMU
+ * off, so the struct is kept in a cache line of its own.
+ *
+ * @stack: Top of the stack
+ * @gd: Global data pointer
+ * @mair: MAIR of the boot CPU
+ * @tcr: TCR of the boot CPU
+ * @ttbr0: TTBR0 of the boot CPU
+ * @sctlr: SCTLR of the boot CPU
+ * @vbar: VBAR of the boot CPU
+ * @func: Function to run
+ * @arg: Argument of @func
+ * @mpidr: Affinity of the CPU
+ * @stack_base: Stack allocated for the CPU
+ */
+struct memtest_cpu {
+	u64 stack;
+	u64 gd;
+	u64 mair;
+	u64 tcr;
+	u64 ttbr0;
+	u64 sctlr;
+	u64 vbar;
+	void (*func)(void *arg);
+	void *arg;
+	u64 mpidr;
+	void *stack_base;
+} __aligned(ARCH_DMA_MINALIGN);
+
+static struct memtest_cpu memtest_cpus[MEMTEST_MAX_CPUS];
+static int memtest_ncpus;
+
+void memtest_secondary_entry(void);
+
+static long memtest_psci(ulong fn, ulong arg1, ulong arg2, ulong arg3)
+{
+	struct pt_regs regs;
+
+	regs.regs[0] = fn;
+	regs.regs[1] = arg1;
+	regs.regs[2] = arg2;
+	regs.regs[3] = arg3;
+	smc_call(&regs);
+
+	return regs.regs[0];
+}
+
+void __noreturn memtest_secondary(struct memtest_cpu *mc)
+{
+	mc->func(mc->arg);
+
+	memtest_psci(ARM_PSCI_0_2_FN_CPU_OFF, 0, 0, 0);
+	while (1)
+		wfi();
+}
+
+static int memtest_read_mpidr(ofnode node, u64 *mpidrp)
+{
+	const fdt32_t *reg;
+	int len;
+
+	reg = ofnode_read_prop(node, "reg", &len);
+	if (reg && len == sizeof(u32))
+		*mpidrp = fdt32_to_cpu(reg[0]);
+	else if (reg && len == sizeof(u64))
+		*mpidrp = (u64)fdt32_to_cpu(reg[0]) << 32 | fdt32_to_cpu(reg[1]);
+	else
+		return -EINVAL;
+
+	return 0;
+}
+
+int memtest_cpu_count(void)
+{
+	const char *method, *type;
+	u64 self, mpidr;
+	ofnode node;
+
+	if (memtest_ncpus)
+		return memtest_ncpus;
+	memtest_ncpus = 1;
+
+	/* The other CPUs can only be started through PSCI firmware in EL3 */
+	method = ofnode_read_string(ofnode_path("/psci"), "method");
+	if (current_el() == 3 || !method || strcmp(method, "smc"))
+		return memtest_ncpus;
+
+	self = read_mpidr() & MPIDR_HWID_MASK;
+	ofnode_for_each_subnode(node, ofnode_path("/cpus")) {
+		type = ofnode_read_string(node, "device_type");
+		method = ofnode_read_string(node, "enable-method");
+		if (!type || strcmp(type, "cpu") || !method ||
+		    strcmp(method, "psci") || memtest_read_mpidr(node, &mpidr))
+			continue;
+		if (mpidr == self || memtest_ncpus == MEMTEST_MAX_CPUS)
+			continue;
+		memtest_cpus[memtest_ncpus++].mpidr = mpidr;
+	}
+
+	return memtest_ncpus;
+}
+
+static void memtest_read_regs(struct memtest_cpu *mc)
+{
+	if (current_el() == 2) {
+		asm volatile("mrs %0, mair_el2" : "=r" (mc->mair));
+		asm volatile("mrs %0, tcr_el2" : "=r" (mc->tcr));
+		asm volatile("mrs %0, ttbr0_el2" : "=r" (mc->ttbr0));
+		asm volatile("mrs %0, sctlr_el2" : "=r" (mc->sctlr));
+		asm volatile("mrs %0, vbar_el2" : "=r" (mc->vbar));
+	} else {
+		asm volatile("mrs %0, mair_el1" : "=r" (mc->mair));
+		asm volatile("mrs %0, tcr_el1" : "=r" (mc->tcr));
+		asm volatile("mrs %0, ttbr0_el1" : "=r" (mc->ttbr0));
+		asm volatile("mrs %0, sctlr_el1" : "=r" (mc->sctlr));
+		asm volatile("mrs %0, vbar_el1" : "=r" (mc->vbar));
+	}
+}
+
+/* Wait for the CPU to turn off after running its last function */
+static int memtest_wait_off(struct memtest_cpu *mc)
+{
+	ulong start = get_timer(0);
+	long state;
+
+	do {
+		state = memtest_psci(ARM_PSCI_0_2_FN64_AFFINITY_INFO, mc->mpidr,
+				     0, 0);
+		if (state == PSCI_AFFINITY_LEVEL_OFF)
+			return 0;
+	} while (get_timer(start) < MEMTEST_OFF_TIMEOUT_MS);
+
+	return -ETIMEDOUT;
+}
+
+int memtest_cpu_call(int cpu, void (*func)(void *arg), void *arg)
+{
+	struct memtest_cpu *mc = &memtest_cpus[cpu];
+	long ret;
+
+	if (!(get_sctlr() & CR_M))
+		return -ENOSYS;
+	if (!mc->stack_base) {
+		mc->stack_base = memalign(16, MEMTEST_STACK_SIZE);
+		if (!mc->stack_base)
+			return -ENOMEM;
+	}
+	if (memtest_wait_off(mc))
+		return -EBUSY;
+
+	mc->stack = (ulong)mc->stack_base + MEMTEST_STACK_SIZE;
+	mc->gd = (ulong)gd;
+	mc->func = func;
+	mc->arg = arg;
+	memtest_read_regs(mc);
+	flush_dcache_range((ulong)mc, (ulong)(mc + 1));
+
+	ret = memtest_psci(ARM_PSCI_0_2_FN64_CPU_ON, mc->mpidr,
+			   (ulong)memtest_secondary_entry, (ulong)mc);
+	if (ret != ARM_PSCI_RET_SUCCESS) {
+		log_debug("Cannot start CPU %llx (err=%ld)\n", mc->mpidr, ret);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+void memtest_cpu_wait(int cpu, struct memtest_part *part)
+{
+	while (!READ_ONCE(part->done))
+		schedule();
+	/* Read the results only after 'done' */
+	rmb();
+}
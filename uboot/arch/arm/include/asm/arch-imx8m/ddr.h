@@ -711,6 +711,9 @@ void load_lpddr4_phy_pie(void);
 void ddrphy_trained_csr_save(struct dram_cfg_param *param, unsigned int num);
 void* dram_config_save(struct dram_timing_info *info, unsigned long base);
 void board_dram_ecc_scrub(void);
+int board_ddrphy_qb_load(void *buf, size_t size);
+void board_ddrphy_qb_store(const void *buf, size_t size);
+int imx8m_ddrphy_qb_store(void);
 void ddrc_inline_ecc_scrub(unsigned int start_address,
 			   unsigned int range_address);
 void ddrc_inline_ecc_scrub_end(unsigned int start_address,
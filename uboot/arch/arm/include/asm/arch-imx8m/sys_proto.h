@@ -15,4 +15,5 @@ void restore_boot_params(void);
 int imx8m_usb_power(int usb_id, bool on);
 extern unsigned long rom_pointer[];
 bool is_usb_boot(void);
+int board_phys_sdram_size(phys_size_t *size);
 #endif
@@ -137,6 +137,17 @@ struct mm_region {
 extern struct mm_region *mem_map;
 void setup_pgtables(void);
 u64 get_tcr(u64 *pips, u64 *pva_bits);
+
+/**
+ * mmu_count_blocks() - count the blocks mapped by the page tables
+ *
+ * This shows how many TLB entries the mappings take at least, since each
+ * block or page needs its own.
+ *
+ * @counts: Returns the number of blocks at each level: [1] for 1 GiB blocks,
+ *	[2] for 2 MiB blocks and [3] for 4 KiB pages. [0] is always 0
+ */
+void mmu_count_blocks(ulong counts[4]);
 #endif
 
 #endif /* _ASM_ARMV8_MMU_H_ */
@@ -146,6 +146,11 @@ enum dcache_option {
 	DCACHE_WRITETHROUGH = 3 << 2,
 	DCACHE_WRITEBACK = 4 << 2,
 	DCACHE_WRITEALLOC = 4 << 2,
+	/*
+	 * Both map to MT_NORMAL_NC, Normal non-cacheable, on ARMv8. Stores to
+	 * it are gathered into bursts.
+	 */
+	DCACHE_WRITECOMBINE = DCACHE_WRITETHROUGH,
 };
 
 #define wfi()				\
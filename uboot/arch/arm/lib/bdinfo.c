@@ -10,6 +10,9 @@
 #include <init.h>
 #include <asm/global_data.h>
 #include <asm/mach-types.h>
+#ifdef CONFIG_ARM64
+#include <asm/armv8/mmu.h>
+#endif
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -27,6 +30,9 @@ int arch_setup_bdinfo(void)
 void arch_print_bdinfo(void)
 {
 	struct bd_info *bd = gd->bd;
+#if defined(CONFIG_ARM64) && !CONFIG_IS_ENABLED(SYS_DCACHE_OFF)
+	ulong blocks[4];
+#endif
 
 	bdinfo_print_num_l("arch_number", bd->bi_arch_number);
 #ifdef CFG_SYS_MEM_RESERVE_SECURE
@@ -42,6 +48,11 @@ void arch_print_bdinfo(void)
 #endif
 #if !(CONFIG_IS_ENABLED(SYS_ICACHE_OFF) && CONFIG_IS_ENABLED(SYS_DCACHE_OFF))
 	bdinfo_print_num_l("TLB addr", gd->arch.tlb_addr);
+#endif
+#if defined(CONFIG_ARM64) && !CONFIG_IS_ENABLED(SYS_DCACHE_OFF)
+	mmu_count_blocks(blocks);
+	printf("%-12s= %lu x 1 GiB, %lu x 2 MiB, %lu x 4 KiB\n", "TLB blocks",
+	       blocks[1], blocks[2], blocks[3]);
 #endif
 	bdinfo_print_num_l("irq_sp", gd->irq_sp);	/* irq stack pointer */
 	bdinfo_print_num_l("sp start ", gd->start_addr_sp);
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Store DDR PHY training results left by SPL on the boot device
+ *
+ * SPL reads saved training results through the ROM API, which cannot write.
+ * After a full training it leaves new results at
+ * CONFIG_IMX8M_DDRPHY_QB_SAVE_ADDR, from where U-Boot writes them to the place
+ * SPL reads them from, so that the next boot can skip the training.
+ */
+
+#include <common.h>
+#include <blk.h>
+#include <ddrphy_qb_cache.h>
+#include <errno.h>
+#include <malloc.h>
+#include <memalign.h>
+#include <mmc.h>
+#include <asm/arch/ddr.h>
+#include <asm/arch/sys_proto.h>
+#include <linux/sizes.h>
+
+/* Most the results can take up in OCRAM_S */
+#define DDRPHY_QB_MAX_SIZE	SZ_4K
+
+static int ddrphy_qb_write(struct blk_desc *desc, ulong offset,
+			   const void *blob, int size)
+{
+	lbaint_t cnt = DIV_ROUND_UP(size, desc->blksz);
+	void *buf;
+	int ret = 0;
+
+	if (offset % desc->blksz)
+		return -EINVAL;
+
+	buf = malloc_cache_aligned(cnt * desc->blksz);
+	if (!buf)
+		return -ENOMEM;
+	memset(buf, '\0', cnt * desc->blksz);
+	memcpy(buf, blob, size);
+	if (blk_dwrite(desc, offset / desc->blksz, cnt, buf) != cnt)
+		ret = -EIO;
+	free(buf);
+
+	return ret;
+}
+
+int imx8m_ddrphy_qb_store(void)
+{
+	struct ddrphy_qb_cache_hdr *hdr =
+		(void *)CONFIG_IMX8M_DDRPHY_QB_SAVE_ADDR;
+	struct blk_desc *desc;
+	struct mmc *mmc;
+	u32 boot, offset;
+	int size, part = 0, orig_part, ret;
+
+	/* SPL only leaves intact results here after a full training */
+	size = ddrphy_qb_cache_saved_size(hdr, DDRPHY_QB_MAX_SIZE);
+	if (size < 0)
+		return 0;
+
+	if (rom_api_query_boot_infor(QUERY_BT_DEV, &boot) != ROM_API_OKAY ||
+	    rom_api_query_boot_infor(QUERY_IMG_OFF, &offset) != ROM_API_OKAY)
+		return -ENODEV;
+	if (boot >> 16 != BT_DEV_TYPE_SD && boot >> 16 != BT_DEV_TYPE_MMC)
+		return -EOPNOTSUPP;
+
+	mmc = find_mmc_device(mmc_get_env_dev());
+	if (!mmc || mmc_init(mmc))
+		return -ENODEV;
+	desc = mmc_get_blk_desc(mmc);
+	if (!desc)
+		return -ENODEV;
+
+	/* the ROM reads from the boot partition it booted from */
+	if (boot >> 16 == BT_DEV_TYPE_MMC) {
+		part = EXT_CSD_EXTRACT_BOOT_PART(mmc->part_config);
+		if (part == 7)
+			part = 0;
+	}
+
+	orig_part = desc->hwpart;
+	ret = blk_dselect_hwpart(desc, part);
+	if (ret)
+		return ret;
+	ret = ddrphy_qb_write(desc, offset + CONFIG_IMX8M_DDRPHY_QB_OFFSET,
+			      hdr, size);
+	blk_dselect_hwpart(desc, orig_part);
+	if (ret)
+		return ret;
+
+	/* do not store the same results again on a warm reset */
+	hdr->magic = 0;
+	printf("DDRINFO: ddrphy training results stored, %d bytes\n", size);
+
+	return 0;
+}
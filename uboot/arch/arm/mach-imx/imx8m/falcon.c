@@ -0,0 +1,384 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Falcon mode for i.MX8M: SPL starts Linux through ATF
+ *
+ * U-Boot prepares the devicetree for Linux with 'spl export fdt' and stores
+ * it on the boot device with 'falcon save'. The stored copy carries a key
+ * made from the CRC of the saved environment, the DRAM size and the SoC
+ * revision, so that saving the environment or moving the card to another
+ * board makes SPL fall back to loading U-Boot until it is saved again.
+ */
+
+#include <common.h>
+#include <blk.h>
+#include <command.h>
+#include <cpu_func.h>
+#include <env.h>
+#include <env_internal.h>
+#include <hang.h>
+#include <malloc.h>
+#include <mapmem.h>
+#include <memalign.h>
+#include <mmc.h>
+#include <serial.h>
+#include <spl.h>
+#include <asm/arch/sys_proto.h>
+#include <u-boot/crc.h>
+
+#define FALCON_ARGS_MAGIC	0x46414c43	/* "FALC" */
+
+/**
+ * struct falcon_args_hdr - header of the stored devicetree
+ *
+ * @magic: FALCON_ARGS_MAGIC
+ * @key: Key of the environment and board the devicetree was prepared for
+ * @size: Size of the devicetree which follows
+ * @crc: CRC32 of the devicetree
+ */
+struct falcon_args_hdr {
+	u32 magic;
+	u32 key;
+	u32 size;
+	u32 crc;
+};
+
+static u32 falcon_key(u32 env_crc)
+{
+	struct {
+		u32 env_crc;
+		u32 cpu_rev;
+		u64 ram_size;
+	} key;
+	phys_size_t size = 0;
+
+	board_phys_sdram_size(&size);
+	key.env_crc = env_crc;
+	key.cpu_rev = get_cpu_rev();
+	key.ram_size = size;
+
+	return crc32(0, (void *)&key, sizeof(key));
+}
+
+static bool falcon_hdr_ok(const struct falcon_args_hdr *hdr, u32 env_crc)
+{
+	return hdr->magic == FALCON_ARGS_MAGIC && hdr->size &&
+	       hdr->size <= CONFIG_IMX8M_FALCON_ARGS_SIZE - sizeof(*hdr) &&
+	       hdr->key == falcon_key(env_crc);
+}
+
+/* Read @size bytes at @offset of the boot device, returning 0 if OK */
+typedef int (*falcon_read_t)(void *priv, ulong offset, ulong size, void *buf);
+
+#ifdef CONFIG_SYS_REDUNDAND_ENVIRONMENT
+static bool falcon_env_ok(falcon_read_t read, void *priv, ulong offset,
+			  env_t *env)
+{
+	return !read(priv, offset, CONFIG_ENV_SIZE, env) &&
+	       crc32(0, env->data, ENV_SIZE) == env->crc;
+}
+
+/*
+ * Get the CRC of the saved environment which U-Boot loads. That is the copy
+ * with a good CRC, or the newer one by its flags if both are good, as in
+ * env_check_redund(). If neither is good U-Boot uses the default
+ * environment, which is given a CRC of 0.
+ */
+static int falcon_env_crc(falcon_read_t read, void *priv, u32 *crcp)
+{
+	env_t *env1, *env2, *env = NULL;
+	bool ok1, ok2;
+
+	env1 = malloc_cache_aligned(CONFIG_ENV_SIZE);
+	env2 = malloc_cache_aligned(CONFIG_ENV_SIZE);
+	if (!env1 || !env2) {
+		free(env1);
+		free(env2);
+		return -ENOMEM;
+	}
+
+	ok1 = falcon_env_ok(read, priv, CONFIG_ENV_OFFSET, env1);
+	ok2 = falcon_env_ok(read, priv, CONFIG_ENV_OFFSET_REDUND, env2);
+	if (ok1 && ok2) {
+		if (env1->flags == 255 && env2->flags == 0)
+			env = env2;
+		else if (env2->flags == 255 && env1->flags == 0)
+			env = env1;
+		else
+			env = env2->flags > env1->flags ? env2 : env1;
+	} else if (ok1 || ok2) {
+		env = ok1 ? env1 : env2;
+	}
+	*crcp = env ? env->crc : 0;
+	free(env1);
+	free(env2);
+
+	return 0;
+}
+#else
+static int falcon_env_crc(falcon_read_t read, void *priv, u32 *crcp)
+{
+	return read(priv, CONFIG_ENV_OFFSET, sizeof(*crcp), crcp);
+}
+#endif
+
+#ifdef CONFIG_SPL_BUILD
+void imx8m_falcon_tramp(void);
+extern u64 imx8m_falcon_tramp_fdt, imx8m_falcon_tramp_entry;
+extern char imx8m_falcon_tramp_end[];
+
+static int falcon_romapi_read(void *priv, ulong offset, ulong size,
+			      void *buf)
+{
+	return spl_romapi_read(offset, size, buf) == size ? 0 : -EIO;
+}
+
+static int falcon_check_args(void)
+{
+	struct falcon_args_hdr hdr, *args;
+	u32 env_crc;
+	int ret;
+
+	ret = falcon_env_crc(falcon_romapi_read, NULL, &env_crc);
+	if (ret)
+		return ret;
+	if (spl_romapi_read(CONFIG_IMX8M_FALCON_ARGS_OFFSET, sizeof(hdr),
+			    &hdr) != sizeof(hdr))
+		return -EIO;
+	if (!falcon_hdr_ok(&hdr, env_crc))
+		return -ENOENT;
+
+	/* Read the devicetree straight to where Linux expects it */
+	args = (void *)CONFIG_SYS_SPL_ARGS_ADDR - sizeof(hdr);
+	if (spl_romapi_read(CONFIG_IMX8M_FALCON_ARGS_OFFSET,
+			    sizeof(hdr) + hdr.size, args) !=
+	    sizeof(hdr) + hdr.size)
+		return -EIO;
+	if (crc32(0, (void *)(args + 1), hdr.size) != hdr.crc)
+		return -EBADMSG;
+
+	return 0;
+}
+
+int spl_start_uboot(void)
+{
+	static int start_uboot = -1;
+	int ret;
+
+	/* Loading an image may ask more than once */
+	if (start_uboot != -1)
+		return start_uboot;
+
+	start_uboot = 1;
+	if (serial_tstc() && serial_getc() == 'c') {
+		puts("Falcon mode: key pressed, loading U-Boot\n");
+		return start_uboot;
+	}
+
+	ret = falcon_check_args();
+	if (ret) {
+		printf("Falcon mode: no valid args (err=%d), loading U-Boot\n",
+		       ret);
+		return start_uboot;
+	}
+	start_uboot = 0;
+
+	return start_uboot;
+}
+
+/*
+ * The i.MX8M ATF ignores the BL31 parameters and enters BL33 at the U-Boot
+ * text base with no arguments, so put a trampoline there which passes the
+ * devicetree to Linux
+ */
+void __noreturn jump_to_image_linux(struct spl_image_info *spl_image)
+{
+	typedef void __noreturn (*image_entry_noargs_t)(void);
+	image_entry_noargs_t atf_entry;
+	ulong tramp = CONFIG_TEXT_BASE;
+	ulong len = imx8m_falcon_tramp_end - (char *)imx8m_falcon_tramp;
+
+	atf_entry = (image_entry_noargs_t)spl_image->atf_entry;
+	if (!atf_entry) {
+		puts("Falcon mode: no ATF in the image\n");
+		hang();
+	}
+
+	memcpy((void *)tramp, imx8m_falcon_tramp, len);
+	*(u64 *)(tramp + ((char *)&imx8m_falcon_tramp_fdt -
+			  (char *)imx8m_falcon_tramp)) = (ulong)spl_image->arg;
+	*(u64 *)(tramp + ((char *)&imx8m_falcon_tramp_entry -
+			  (char *)imx8m_falcon_tramp)) = spl_image->entry_point;
+	flush_dcache_range(tramp, tramp + len);
+	invalidate_icache_all();
+
+	debug("Entering ATF at %p, kernel arg pointer: 0x%p\n", atf_entry,
+	      spl_image->arg);
+	atf_entry();
+}
+#else
+static struct blk_desc *falcon_blk(void)
+{
+	struct blk_desc *desc;
+	struct mmc *mmc;
+
+	mmc = find_mmc_device(mmc_get_env_dev());
+	if (!mmc || mmc_init(mmc))
+		return NULL;
+	desc = mmc_get_blk_desc(mmc);
+	if (!desc || blk_dselect_hwpart(desc, 0))
+		return NULL;
+
+	return desc;
+}
+
+/* Read @size bytes at @offset, returning a buffer the caller must free */
+static void *falcon_blk_read(struct blk_desc *desc, ulong offset, ulong size)
+{
+	lbaint_t start = offset / desc->blksz;
+	lbaint_t cnt = DIV_ROUND_UP(size, desc->blksz);
+	void *buf;
+
+	buf = malloc_cache_aligned(cnt * desc->blksz);
+	if (!buf)
+		return NULL;
+	if (blk_dread(desc, start, cnt, buf) != cnt) {
+		free(buf);
+		return NULL;
+	}
+
+	return buf;
+}
+
+static int falcon_blk_read_to(void *priv, ulong offset, ulong size,
+			      void *buf)
+{
+	void *data;
+
+	data = falcon_blk_read(priv, offset, size);
+	if (!data)
+		return -EIO;
+	memcpy(buf, data, size);
+	free(data);
+
+	return 0;
+}
+
+static int falcon_stored_env_crc(struct blk_desc *desc, u32 *crcp)
+{
+	return falcon_env_crc(falcon_blk_read_to, desc, crcp);
+}
+
+static int do_falcon_check(struct cmd_tbl *cmdtp, int flag, int argc,
+			   char *const argv[])
+{
+	struct falcon_args_hdr *hdr;
+	struct blk_desc *desc;
+	u32 env_crc;
+	bool ok;
+
+	desc = falcon_blk();
+	if (!desc || falcon_stored_env_crc(desc, &env_crc))
+		return CMD_RET_FAILURE;
+	hdr = falcon_blk_read(desc, CONFIG_IMX8M_FALCON_ARGS_OFFSET,
+			      CONFIG_IMX8M_FALCON_ARGS_SIZE);
+	if (!hdr)
+		return CMD_RET_FAILURE;
+
+	ok = falcon_hdr_ok(hdr, env_crc) &&
+	     crc32(0, (void *)(hdr + 1), hdr->size) == hdr->crc;
+	free(hdr);
+	if (!ok) {
+		printf("Falcon mode args missing or out of date\n");
+		return CMD_RET_FAILURE;
+	}
+
+	return 0;
+}
+
+static int falcon_write(struct blk_desc *desc, void *buf, ulong size)
+{
+	lbaint_t cnt = DIV_ROUND_UP(size, desc->blksz);
+
+	if (blk_dwrite(desc, CONFIG_IMX8M_FALCON_ARGS_OFFSET / desc->blksz,
+		       cnt, buf) != cnt)
+		return -EIO;
+
+	return 0;
+}
+
+static int do_falcon_save(struct cmd_tbl *cmdtp, int flag, int argc,
+			  char *const argv[])
+{
+	struct falcon_args_hdr *hdr;
+	struct blk_desc *desc;
+	ulong addr, size;
+	u32 env_crc;
+	int ret;
+
+	addr = env_get_hex("fdtargsaddr", 0);
+	size = env_get_hex("fdtargslen", 0);
+	if (!addr || !size) {
+		printf("Run 'spl export fdt' first\n");
+		return CMD_RET_FAILURE;
+	}
+	if (size > CONFIG_IMX8M_FALCON_ARGS_SIZE - sizeof(*hdr)) {
+		printf("Devicetree too large (%lx bytes)\n", size);
+		return CMD_RET_FAILURE;
+	}
+
+	/*
+	 * Use the saved environment, which is what SPL sees, rather than the
+	 * one in memory, which always differs by the variables set at run time
+	 */
+	desc = falcon_blk();
+	if (!desc || falcon_stored_env_crc(desc, &env_crc))
+		return CMD_RET_FAILURE;
+
+	hdr = malloc_cache_aligned(ALIGN(sizeof(*hdr) + size, desc->blksz));
+	if (!hdr)
+		return CMD_RET_FAILURE;
+	hdr->magic = FALCON_ARGS_MAGIC;
+	hdr->key = falcon_key(env_crc);
+	hdr->size = size;
+	memcpy(hdr + 1, map_sysmem(addr, size), size);
+	hdr->crc = crc32(0, (void *)(hdr + 1), size);
+
+	ret = falcon_write(desc, hdr, sizeof(*hdr) + size);
+	free(hdr);
+	if (ret)
+		return CMD_RET_FAILURE;
+	printf("Falcon mode args saved (%lx bytes)\n", size);
+
+	return 0;
+}
+
+static int do_falcon_clear(struct cmd_tbl *cmdtp, int flag, int argc,
+			   char *const argv[])
+{
+	struct blk_desc *desc;
+	void *buf;
+	int ret;
+
+	desc = falcon_blk();
+	if (!desc)
+		return CMD_RET_FAILURE;
+	buf = malloc_cache_aligned(desc->blksz);
+	if (!buf)
+		return CMD_RET_FAILURE;
+	memset(buf, '\0', desc->blksz);
+	ret = falcon_write(desc, buf, desc->blksz);
+	free(buf);
+
+	return ret ? CMD_RET_FAILURE : 0;
+}
+
+static char falcon_help_text[] =
+	"check - check that the stored args match the saved environment\n"
+	"falcon save  - store the devicetree from 'spl export fdt' for SPL\n"
+	"falcon clear - remove the stored args, so SPL loads U-Boot";
+
+U_BOOT_CMD_WITH_SUBCMDS(falcon, "Falcon mode boot", falcon_help_text,
+	U_BOOT_SUBCMD_MKENT(check, 1, 1, do_falcon_check),
+	U_BOOT_SUBCMD_MKENT(save, 1, 0, do_falcon_save),
+	U_BOOT_SUBCMD_MKENT(clear, 1, 0, do_falcon_clear));
+#endif
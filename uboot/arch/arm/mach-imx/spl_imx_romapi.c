@@ -87,7 +87,7 @@ ulong __weak spl_romapi_get_uboot_base(u32 image_offset, u32 rom_bt_dev, u32 pag
 	return offset;
 }
 
-static int is_boot_from_stream_device(u32 boot)
+int is_boot_from_stream_device(u32 boot)
 {
 	u32 interface;
 
@@ -170,7 +170,13 @@ static int spl_romapi_load_image_seekable(struct spl_image_info *spl_image,
 	printf("image offset 0x%x, pagesize 0x%x, ivt offset 0x%x\n",
 	       image_offset, pagesize, offset);
 
-	offset = spl_romapi_get_uboot_base(image_offset, rom_bt_dev, pagesize);
+	/* In Falcon mode, load the FIT holding Linux and ATF instead */
+	if (IS_ENABLED(CONFIG_IMX8M_FALCON) && !spl_start_uboot())
+		offset = IF_ENABLED_INT(CONFIG_IMX8M_FALCON,
+					CONFIG_IMX8M_FALCON_KERNEL_OFFSET);
+	else
+		offset = spl_romapi_get_uboot_base(image_offset, rom_bt_dev,
+						   pagesize);
 
 	size = ALIGN(sizeof(struct legacy_img_hdr), pagesize);
 	ret = rom_api_download_image((u8 *)header, offset, size);
@@ -320,6 +326,170 @@ static int img_total_size(void *img_hdr)
 	return 0;
 }
 
+#define ROMAPI_STREAM_PLACED_MAX	8
+
+/*
+ * A stream device can only be read forward. Whole pages of an image are
+ * downloaded straight to where the image is loaded; anything else, such as
+ * data skipped on the way to the next image, goes to a scratch area which
+ * mirrors the stream, in case it is asked for later.
+ */
+struct romapi_stream {
+	u8 *base;	/* scratch area, holding the stream from its start */
+	ulong start;	/* offset of the image header in the stream */
+	ulong pos;	/* bytes downloaded so far, a multiple of pagesize */
+	u32 pagesize;
+	int nr_placed;
+	struct {
+		ulong start;
+		ulong end;
+	} placed[ROMAPI_STREAM_PLACED_MAX];	/* not in the scratch area */
+};
+
+static int spl_romapi_stream_download(struct romapi_stream *st, void *buf,
+				      ulong size)
+{
+	if (rom_api_download_image(buf, 0, size) != ROM_API_OKAY) {
+		printf("Stream(USB) download failure at 0x%lx, size 0x%lx\n",
+		       st->pos, size);
+		return -EIO;
+	}
+	st->pos += size;
+
+	return 0;
+}
+
+/*
+ * Record that stream data from @off to @off + @size is downloaded straight
+ * to @buf, returning false if it has to go through the scratch area instead
+ */
+static bool spl_romapi_stream_place(struct romapi_stream *st, ulong off,
+				    void *buf, ulong size)
+{
+	int last = st->nr_placed - 1;
+
+	/* ROM does not allow to access the ocram 0x980000 to 0x98ffff ecc region */
+	if (is_imx8mp() && (ulong)buf <= 0x98ffff &&
+	    (ulong)buf + size > 0x980000)
+		return false;
+
+	/*
+	 * Only merge with a range this one touches or overlaps: the scratch
+	 * page between two parts of an image is still in the scratch area and
+	 * can be copied from later.
+	 */
+	if (last >= 0 && off <= st->placed[last].end) {
+		st->placed[last].end = max(st->placed[last].end, off + size);
+		return true;
+	}
+	if (st->nr_placed == ROMAPI_STREAM_PLACED_MAX)
+		return false;
+
+	st->placed[st->nr_placed].start = off;
+	st->placed[st->nr_placed].end = off + size;
+	st->nr_placed++;
+
+	return true;
+}
+
+static ulong spl_romapi_read_stream(struct spl_load_info *load, ulong sector,
+				    ulong count, void *buf)
+{
+	struct romapi_stream *st = load->priv;
+	ulong off = st->start + sector;
+	ulong end = off + count;
+	ulong n;
+	int i;
+
+	/* Data the stream has already gone past */
+	if (off < st->pos) {
+		n = min(end, st->pos);
+		for (i = 0; i < st->nr_placed; i++) {
+			if (off < st->placed[i].end && n > st->placed[i].start) {
+				printf("Stream data at 0x%lx is already loaded\n",
+				       off);
+				return 0;
+			}
+		}
+		memcpy(buf, st->base + off, n - off);
+		buf += n - off;
+		off = n;
+	}
+
+	/* Keep what is skipped, up to the page holding the next byte */
+	if (off < end && rounddown(off, st->pagesize) > st->pos) {
+		n = rounddown(off, st->pagesize) - st->pos;
+		if (spl_romapi_stream_download(st, st->base + st->pos, n))
+			return 0;
+	}
+
+	/* The first, partial page of the data */
+	if (off < end && off > st->pos) {
+		if (spl_romapi_stream_download(st, st->base + st->pos,
+					       st->pagesize))
+			return 0;
+		n = min(end, st->pos);
+		memcpy(buf, st->base + off, n - off);
+		buf += n - off;
+		off = n;
+	}
+
+	/* Whole pages, downloaded to their destination */
+	n = rounddown(end - off, st->pagesize);
+	if (off < end && n && spl_romapi_stream_place(st, off, buf, n)) {
+		if (spl_romapi_stream_download(st, buf, n))
+			return 0;
+		buf += n;
+		off += n;
+	}
+
+	/* Whatever is left goes through the scratch area */
+	if (off < end) {
+		n = roundup(end, st->pagesize) - st->pos;
+		if (spl_romapi_stream_download(st, st->base + st->pos, n))
+			return 0;
+		memcpy(buf, st->base + off, end - off);
+	}
+
+	return count;
+}
+
+/*
+ * Load the images from the stream as the loader asks for them, rather than
+ * downloading the whole image first and copying it over. @p is where the
+ * stream has been downloaded up to, @phdr the image header within it.
+ */
+static int spl_romapi_load_stream_in_place(struct spl_image_info *spl_image,
+					   u8 *phdr, u8 *p, u32 pagesize)
+{
+	struct spl_load_info load;
+	struct romapi_stream st;
+	int ret;
+
+	st.base = (u8 *)CONFIG_SPL_IMX_ROMAPI_LOADADDR;
+	st.start = phdr - st.base;
+	st.pos = p - st.base;
+	st.pagesize = pagesize;
+	st.nr_placed = 0;
+
+	memset(&load, 0, sizeof(load));
+	load.bl_len = 1;
+	load.read = spl_romapi_read_stream;
+	load.priv = &st;
+
+	if (IS_ENABLED(CONFIG_SPL_LOAD_FIT))
+		ret = spl_load_simple_fit(spl_image, &load, 0, phdr);
+	else if (IS_ENABLED(CONFIG_SPL_LOAD_IMX_CONTAINER))
+		ret = spl_load_imx_container(spl_image, &load, 0);
+	else
+		ret = -1;
+
+	debug("Stream: %lu bytes read, %d ranges loaded in place\n",
+	      st.pos - st.start, st.nr_placed);
+
+	return ret;
+}
+
 static int spl_romapi_load_image_stream(struct spl_image_info *spl_image,
 					struct spl_boot_device *bootdev)
 {
@@ -394,6 +564,10 @@ static int spl_romapi_load_image_stream(struct spl_image_info *spl_image,
 		}
 	}
 
+	if (IS_ENABLED(CONFIG_SPL_IMX_ROMAPI_STREAM_IN_PLACE))
+		return spl_romapi_load_stream_in_place(spl_image, phdr, p,
+						       pagesize);
+
 	total = img_total_size(phdr);
 	total += 3;
 	total &= ~0x3;
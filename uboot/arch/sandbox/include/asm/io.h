@@ -30,6 +30,11 @@ void unmap_physmem(const void *vaddr, unsigned long flags);
 
 #include <asm-generic/io.h>
 
+/* Sandbox runs on a single host thread, so only the compiler can reorder */
+#define mb()		barrier()
+#define rmb()		mb()
+#define wmb()		mb()
+
 /* For sandbox, we want addresses to point into our RAM buffer */
 static inline void *map_sysmem(phys_addr_t paddr, unsigned long len)
 {
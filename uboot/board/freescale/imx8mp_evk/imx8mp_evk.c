@@ -17,6 +17,7 @@
 #include <asm-generic/gpio.h>
 #include <asm/arch/imx8mp_pins.h>
 #include <asm/arch/clock.h>
+#include <asm/arch/ddr.h>
 #include <asm/arch/sys_proto.h>
 #include <asm/mach-imx/gpio.h>
 #include <asm/mach-imx/mxc_i2c.h>
@@ -472,9 +473,17 @@ int board_init(void)
 
 int board_late_init(void)
 {
+	int ret;
+
 #ifdef CONFIG_ENV_IS_IN_MMC
 	board_late_mmc_env_init();
 #endif
+	if (IS_ENABLED(CONFIG_IMX8M_DDRPHY_QB_STORE)) {
+		ret = imx8m_ddrphy_qb_store();
+		if (ret)
+			printf("DDRINFO: cannot store ddrphy training results (%d)\n",
+			       ret);
+	}
 #ifdef CONFIG_ENV_VARS_UBOOT_RUNTIME_CONFIG
 	env_set("board_name", "EVK");
 	env_set("board_rev", "iMX8MP");
@@ -63,14 +63,22 @@ static void boot_start_lmb(struct bootm_headers *images)
 	lmb_init_and_reserve_range(&images->lmb, (phys_addr_t)mem_start,
 				   mem_size, NULL);
 }
+
+static void boot_stop_lmb(struct bootm_headers *images)
+{
+	/* Free the region lists if the last bootm grew them */
+	lmb_uninit(&images->lmb);
+}
 #else
 #define lmb_reserve(lmb, base, size)
 static inline void boot_start_lmb(struct bootm_headers *images) { }
+static inline void boot_stop_lmb(struct bootm_headers *images) { }
 #endif
 
 static int bootm_start(struct cmd_tbl *cmdtp, int flag, int argc,
 		       char *const argv[])
 {
+	boot_stop_lmb(&images);
 	memset((void *)&images, 0, sizeof(images));
 	images.verify = env_get_yesno("verify");
 
@@ -401,7 +409,7 @@ static int bootm_load_os(struct bootm_headers *images, int boot_progress)
 {
 	struct image_info os = images->os;
 	ulong load = os.load;
-	ulong load_end;
+	ulong load_end, mem_end;
 	ulong blob_start = os.start;
 	ulong blob_end = os.end;
 	ulong image_start = os.image_start;
@@ -451,8 +459,21 @@ static int bootm_load_os(struct bootm_headers *images, int boot_progress)
 		}
 	}
 
-	lmb_reserve(&images->lmb, images->os.load, (load_end -
-						    images->os.load));
+	/*
+	 * An arm64 Image uses image_size bytes from its start, which includes
+	 * its BSS and so goes beyond what was loaded. Reserve all of it, so
+	 * that nothing placed later, such as a ramdisk, ends up there.
+	 */
+	mem_end = load_end;
+	if (IS_ENABLED(CONFIG_CMD_BOOTI) && os.arch == IH_ARCH_ARM64 &&
+	    os.os == IH_OS_LINUX) {
+		ulong relocated_addr, image_size;
+
+		if (!booti_setup(load, &relocated_addr, &image_size, false))
+			mem_end = max(load_end, load + image_size);
+	}
+
+	lmb_reserve(&images->lmb, load, mem_end - load);
 	return 0;
 }
 
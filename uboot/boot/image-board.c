@@ -552,6 +552,46 @@ int boot_get_ramdisk(int argc, char *const argv[], struct bootm_headers *images,
 	return 0;
 }
 
+/* Get the "initrd_high" limit, clearing @copy_to_ram if it is ~0 */
+static ulong boot_get_initrd_high(int *copy_to_ram)
+{
+	char	*s;
+	ulong	initrd_high;
+
+	*copy_to_ram = 1;
+	s = env_get("initrd_high");
+	if (s) {
+		/* a value of "no" or a similar string will act like 0,
+		 * turning the "load high" feature off. This is intentional.
+		 */
+		initrd_high = hextoul(s, NULL);
+		if (initrd_high == ~0)
+			*copy_to_ram = 0;
+	} else {
+		initrd_high = env_get_bootm_mapsize() + env_get_bootm_low();
+	}
+
+	return initrd_high;
+}
+
+/* Check that a ramdisk lies below @initrd_high in memory free in @lmb */
+static bool boot_ramdisk_fits(struct lmb *lmb, ulong initrd_high,
+			      ulong rd_data, ulong rd_len)
+{
+	return (!initrd_high || rd_data + rd_len <= initrd_high) &&
+	       lmb_get_free_size(lmb, rd_data) >= rd_len;
+}
+
+bool boot_ramdisk_in_place(struct lmb *lmb, ulong rd_data, ulong rd_len)
+{
+	int copy_to_ram;
+	ulong initrd_high = boot_get_initrd_high(&copy_to_ram);
+
+	return !copy_to_ram ||
+	       (IS_ENABLED(CONFIG_SYS_BOOT_RAMDISK_IN_PLACE) &&
+		boot_ramdisk_fits(lmb, initrd_high, rd_data, rd_len));
+}
+
 /**
  * boot_ramdisk_high - relocate init ramdisk
  * @lmb: pointer to lmb handle, will be used for memory mgmt
@@ -564,6 +604,8 @@ int boot_get_ramdisk(int argc, char *const argv[], struct bootm_headers *images,
  *
  * boot_ramdisk_high() takes a relocation hint from "initrd_high" environment
  * variable and if requested ramdisk data is moved to a specified location.
+ * With CONFIG_SYS_BOOT_RAMDISK_IN_PLACE, ramdisk data which already lies
+ * below initrd_high in memory not reserved in @lmb is left where it is.
  *
  * Initrd_start and initrd_end are set to final (after relocation) ramdisk
  * start/end addresses if ramdisk image start and len were provided,
@@ -576,25 +618,23 @@ int boot_get_ramdisk(int argc, char *const argv[], struct bootm_headers *images,
 int boot_ramdisk_high(struct lmb *lmb, ulong rd_data, ulong rd_len,
 		      ulong *initrd_start, ulong *initrd_end)
 {
-	char	*s;
 	ulong	initrd_high;
-	int	initrd_copy_to_ram = 1;
+	int	initrd_copy_to_ram;
 
-	s = env_get("initrd_high");
-	if (s) {
-		/* a value of "no" or a similar string will act like 0,
-		 * turning the "load high" feature off. This is intentional.
-		 */
-		initrd_high = hextoul(s, NULL);
-		if (initrd_high == ~0)
-			initrd_copy_to_ram = 0;
-	} else {
-		initrd_high = env_get_bootm_mapsize() + env_get_bootm_low();
-	}
+	initrd_high = boot_get_initrd_high(&initrd_copy_to_ram);
 
 	debug("## initrd_high = 0x%08lx, copy_to_ram = %d\n",
 	      initrd_high, initrd_copy_to_ram);
 
+	/*
+	 * A ramdisk which was loaded to free memory that the kernel can reach
+	 * is used where it is, rather than copied again
+	 */
+	if (IS_ENABLED(CONFIG_SYS_BOOT_RAMDISK_IN_PLACE) &&
+	    rd_data && initrd_copy_to_ram &&
+	    boot_ramdisk_fits(lmb, initrd_high, rd_data, rd_len))
+		initrd_copy_to_ram = 0;
+
 	if (rd_data) {
 		if (!initrd_copy_to_ram) {	/* zero-copy ramdisk support */
 			debug("   in-place initrd\n");
@@ -619,8 +659,12 @@ int boot_ramdisk_high(struct lmb *lmb, ulong rd_data, ulong rd_len,
 			printf("   Loading Ramdisk to %08lx, end %08lx ... ",
 			       *initrd_start, *initrd_end);
 
-			memmove_wd((void *)*initrd_start,
-				   (void *)rd_data, rd_len, CHUNKSZ);
+			bootstage_start(BOOTSTAGE_ID_ACCUM_IMAGE_COPY,
+					"image_copy");
+			memmove_wd(map_sysmem(*initrd_start, rd_len),
+				   map_sysmem(rd_data, rd_len), rd_len, CHUNKSZ);
+			bootstage_accum_size(BOOTSTAGE_ID_ACCUM_IMAGE_COPY,
+					     rd_len);
 
 			/*
 			 * Ensure the image is flushed to memory to handle
@@ -1253,23 +1253,23 @@ int fit_set_timestamp(void *fit, int noffset, time_t timestamp)
 int calculate_hash(const void *data, int data_len, const char *name,
 			uint8_t *value, int *value_len)
 {
-#if !defined(USE_HOSTCC) && defined(CONFIG_DM_HASH)
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(DM_HASH)
 	int rc;
 	enum HASH_ALGO hash_algo;
 	struct udevice *dev;
 
-	rc = uclass_get_device(UCLASS_HASH, 0, &dev);
-	if (rc) {
-		debug("failed to get hash device, rc=%d\n", rc);
-		return -1;
-	}
-
 	hash_algo = hash_algo_lookup_by_name(name);
 	if (hash_algo == HASH_ALGO_INVALID) {
 		debug("Unsupported hash algorithm\n");
 		return -1;
 	};
 
+	rc = hash_get_device(hash_algo, &dev);
+	if (rc) {
+		debug("failed to get hash device, rc=%d\n", rc);
+		return -1;
+	}
+
 	rc = hash_digest_wd(dev, hash_algo, data, data_len, value, CHUNKSZ);
 	if (rc) {
 		debug("failed to get hash value, rc=%d\n", rc);
@@ -1294,8 +1294,297 @@ int calculate_hash(const void *data, int data_len, const char *name,
 	return 0;
 }
 
-static int fit_image_check_hash(const void *fit, int noffset, const void *data,
-				size_t size, char **err_msgp)
+/* Configuration properties which hold the names of image nodes */
+static const char *const fit_conf_image_props[] = {
+	FIT_KERNEL_PROP,
+	FIT_RAMDISK_PROP,
+	FIT_FDT_PROP,
+	FIT_LOADABLE_PROP,
+	FIT_SETUP_PROP,
+	FIT_FPGA_PROP,
+	FIT_FIRMWARE_PROP,
+	FIT_STANDALONE_PROP,
+	FIT_SCRIPT_PROP,
+};
+
+/**
+ * fit_conf_uses_image() - check if a configuration refers to an image
+ * @fit: pointer to the FIT format image header
+ * @conf_noffset: configuration node offset, or -ve to match every image
+ * @image_name: unit name of the image node
+ *
+ * Looks for @image_name in the image-reference properties of the
+ * configuration (kernel, fdt, ramdisk, loadables and the like). Other
+ * string properties, such as description or compatible, are ignored.
+ *
+ * returns:
+ *     true, if the image is used by the configuration, or @conf_noffset
+ *           is negative
+ *     false, otherwise
+ */
+static bool fit_conf_uses_image(const void *fit, int conf_noffset,
+				const char *image_name)
+{
+	const char *prop, *uname;
+	int i, j;
+
+	if (conf_noffset < 0)
+		return true;
+
+	for (i = 0; i < ARRAY_SIZE(fit_conf_image_props); i++) {
+		prop = fit_conf_image_props[i];
+		for (j = 0;
+		     (uname = fdt_stringlist_get(fit, conf_noffset, prop, j,
+						 NULL));
+		     j++) {
+			if (!strcmp(uname, image_name))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(FIT_BATCH_HASH)
+/*
+ * SHA-256 digests of small images, computed together by
+ * fit_all_image_verify() before it checks the images one by one
+ */
+#define FIT_BATCH_HASH_MAX_SIZE	SZ_64K
+#define FIT_BATCH_HASH_MAX	16
+
+struct fit_batch_hash {
+	const void *data;
+	size_t size;
+	uint8_t value[SHA256_SUM_LEN];
+};
+
+static struct fit_batch_hash fit_batch[FIT_BATCH_HASH_MAX];
+static int fit_batch_count;
+
+#if CONFIG_IS_ENABLED(DM_HASH)
+/* Get a hash engine which is faster at SHA-256 than the CPU, if any */
+static struct udevice *fit_batch_hash_dev(void)
+{
+	struct hash_uc_plat *uc_plat;
+	struct udevice *dev;
+
+	if (hash_get_device(HASH_ALGO_SHA256, &dev))
+		return NULL;
+	uc_plat = dev_get_uclass_plat(dev);
+	if (uc_plat->prio[HASH_ALGO_SHA256] != HASH_PRIO_HW)
+		return NULL;
+
+	return dev;
+}
+
+/*
+ * Queue all the jobs on the engine before waiting for any of them, so that
+ * it can work through them back to back
+ */
+static int fit_batch_hash_queue(struct udevice *dev,
+				struct sha256_mb_job *jobs, int count)
+{
+	void *reqs[FIT_BATCH_HASH_MAX];
+	int i, ret = 0;
+
+	for (i = 0; i < count; i++) {
+		ret = hash_digest_start(dev, HASH_ALGO_SHA256, jobs[i].input,
+					jobs[i].ilen, jobs[i].output, &reqs[i]);
+		if (ret)
+			break;
+	}
+
+	/* Wait for every job which was started, even after an error */
+	count = i;
+	for (i = 0; i < count; i++) {
+		if (hash_digest_wait(dev, reqs[i]) && !ret)
+			ret = -EIO;
+	}
+
+	return ret;
+}
+#else
+static struct udevice *fit_batch_hash_dev(void)
+{
+	return NULL;
+}
+
+static int fit_batch_hash_queue(struct udevice *dev,
+				struct sha256_mb_job *jobs, int count)
+{
+	return -ENOSYS;
+}
+#endif
+
+static void fit_batch_hash_images(const void *fit, int images_noffset,
+				  int conf_noffset)
+{
+	struct sha256_mb_job jobs[FIT_BATCH_HASH_MAX], job;
+	struct fit_batch_hash *entry;
+	int noffset, hash_noffset;
+	struct udevice *dev;
+	const char *algo;
+	const void *data;
+	size_t size;
+	int i, j;
+
+	/*
+	 * A hash engine takes images of any size, while the CPU only gains
+	 * from hashing small ones together
+	 */
+	dev = fit_batch_hash_dev();
+
+	fit_batch_count = 0;
+	fdt_for_each_subnode(noffset, fit, images_noffset) {
+		if (fit_batch_count == FIT_BATCH_HASH_MAX)
+			break;
+		if (!fit_conf_uses_image(fit, conf_noffset,
+					 fit_get_name(fit, noffset, NULL)))
+			continue;
+		if (fit_image_get_data_and_size(fit, noffset, &data, &size) ||
+		    (!dev && size > FIT_BATCH_HASH_MAX_SIZE))
+			continue;
+
+		fdt_for_each_subnode(hash_noffset, fit, noffset) {
+			if (strncmp(fit_get_name(fit, hash_noffset, NULL),
+				    FIT_HASH_NODENAME,
+				    strlen(FIT_HASH_NODENAME)))
+				continue;
+			if (fit_image_hash_get_algo(fit, hash_noffset, &algo) ||
+			    strcmp(algo, "sha256"))
+				continue;
+
+			entry = &fit_batch[fit_batch_count];
+			entry->data = data;
+			entry->size = size;
+			jobs[fit_batch_count].input = data;
+			jobs[fit_batch_count].ilen = size;
+			jobs[fit_batch_count].output = entry->value;
+			fit_batch_count++;
+			break;
+		}
+	}
+
+	if (dev) {
+		if (!fit_batch_hash_queue(dev, jobs, fit_batch_count))
+			return;
+		/* Otherwise hash them again in software */
+	}
+
+	/* Sort by length so that paired messages share most of their blocks */
+	for (i = 1; i < fit_batch_count; i++) {
+		job = jobs[i];
+		for (j = i; j > 0 && jobs[j - 1].ilen > job.ilen; j--)
+			jobs[j] = jobs[j - 1];
+		jobs[j] = job;
+	}
+
+	sha256_csum_mb(jobs, fit_batch_count);
+}
+
+static void fit_batch_hash_clear(void)
+{
+	fit_batch_count = 0;
+}
+
+static bool fit_batch_hash_lookup(const void *data, size_t size,
+				  const char *algo, uint8_t *value,
+				  int *value_len)
+{
+	int i;
+
+	if (strcmp(algo, "sha256"))
+		return false;
+
+	for (i = 0; i < fit_batch_count; i++) {
+		if (fit_batch[i].data == data && fit_batch[i].size == size) {
+			memcpy(value, fit_batch[i].value, SHA256_SUM_LEN);
+			*value_len = SHA256_SUM_LEN;
+			return true;
+		}
+	}
+
+	return false;
+}
+#else
+static void fit_batch_hash_images(const void *fit, int images_noffset,
+				  int conf_noffset)
+{
+}
+
+static void fit_batch_hash_clear(void)
+{
+}
+
+static bool fit_batch_hash_lookup(const void *data, size_t size,
+				  const char *algo, uint8_t *value,
+				  int *value_len)
+{
+	return false;
+}
+#endif
+
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(FIT_STREAM_HASH)
+/* Digest of an image which the loader computed while reading it */
+static struct {
+	const void *fit;
+	int noffset;
+	const void *data;
+	size_t size;
+	const char *algo;
+	uint8_t value[FIT_MAX_HASH_LEN];
+	int value_len;
+} fit_stream_hash;
+
+void fit_image_set_hash(const void *fit, int noffset, const void *data,
+			size_t size, const char *algo, const uint8_t *value,
+			int value_len)
+{
+	fit_stream_hash.fit = fit;
+	fit_stream_hash.noffset = noffset;
+	fit_stream_hash.data = data;
+	fit_stream_hash.size = size;
+	fit_stream_hash.algo = algo;
+	memcpy(fit_stream_hash.value, value, value_len);
+	fit_stream_hash.value_len = value_len;
+}
+
+void fit_image_clear_hash(void)
+{
+	fit_stream_hash.data = NULL;
+}
+
+static bool fit_stream_hash_lookup(const void *fit, int image_noffset,
+				   const void *data, size_t size,
+				   const char *algo, uint8_t *value,
+				   int *value_len)
+{
+	if (!fit_stream_hash.data || fit_stream_hash.fit != fit ||
+	    fit_stream_hash.noffset != image_noffset ||
+	    fit_stream_hash.data != data || fit_stream_hash.size != size ||
+	    strcmp(fit_stream_hash.algo, algo))
+		return false;
+
+	memcpy(value, fit_stream_hash.value, fit_stream_hash.value_len);
+	*value_len = fit_stream_hash.value_len;
+	fit_stream_hash.data = NULL;
+
+	return true;
+}
+#else
+static bool fit_stream_hash_lookup(const void *fit, int image_noffset,
+				   const void *data, size_t size,
+				   const char *algo, uint8_t *value,
+				   int *value_len)
+{
+	return false;
+}
+#endif
+
+static int fit_image_check_hash(const void *fit, int image_noffset,
+				int noffset, const void *data, size_t size,
+				char **err_msgp)
 {
 	ALLOC_CACHE_ALIGN_BUFFER(uint8_t, value, FIT_MAX_HASH_LEN);
 	int value_len;
@@ -1326,7 +1615,10 @@ static int fit_image_check_hash(const void *fit, int noffset, const void *data,
 		return -1;
 	}
 
-	if (calculate_hash(data, size, algo, value, &value_len)) {
+	if (!fit_stream_hash_lookup(fit, image_noffset, data, size, algo, value,
+				    &value_len) &&
+	    !fit_batch_hash_lookup(data, size, algo, value, &value_len) &&
+	    calculate_hash(data, size, algo, value, &value_len)) {
 		*err_msgp = "Unsupported hash algorithm";
 		return -1;
 	}
@@ -1370,8 +1662,8 @@ int fit_image_verify_with_data(const void *fit, int image_noffset,
 		 */
 		if (!strncmp(name, FIT_HASH_NODENAME,
 			     strlen(FIT_HASH_NODENAME))) {
-			if (fit_image_check_hash(fit, noffset, data, size,
-						 &err_msg))
+			if (fit_image_check_hash(fit, image_noffset, noffset,
+						 data, size, &err_msg))
 				goto error;
 			puts("+ ");
 		} else if (FIT_IMAGE_ENABLE_VERIFY && verify_all &&
@@ -1442,18 +1734,23 @@ err:
 }
 
 /**
- * fit_all_image_verify - verify data integrity for all images
+ * fit_conf_image_verify - verify data integrity for images of a configuration
  * @fit: pointer to the FIT format image header
+ * @conf_noffset: configuration node offset, or -ve for all images
  *
- * fit_all_image_verify() goes over all images in the FIT and
- * for every images checks if all it's hashes are valid.
+ * fit_conf_image_verify() goes over all images in the FIT and for every
+ * image used by the configuration checks if all it's hashes are valid.
+ * Images the configuration does not refer to are reported as skipped and
+ * not hashed at all.
  *
  * returns:
- *     1, if all hashes of all images are valid
+ *     1, if all hashes of all checked images are valid
  *     0, otherwise (or on error)
  */
-int fit_all_image_verify(const void *fit)
+int fit_conf_image_verify(const void *fit, int conf_noffset)
 {
+	const char *conf_name = NULL;
+	const char *name;
 	int images_noffset;
 	int noffset;
 	int ndepth;
@@ -1467,9 +1764,13 @@ int fit_all_image_verify(const void *fit)
 		return 0;
 	}
 
+	if (conf_noffset >= 0)
+		conf_name = fit_get_name(fit, conf_noffset, NULL);
+
 	/* Process all image subnodes, check hashes for each */
 	printf("## Checking hash(es) for FIT Image at %08lx ...\n",
 	       (ulong)fit);
+	fit_batch_hash_images(fit, images_noffset, conf_noffset);
 	for (ndepth = 0, count = 0,
 	     noffset = fdt_next_node(fit, images_noffset, &ndepth);
 			(noffset >= 0) && (ndepth > 0);
@@ -1479,18 +1780,44 @@ int fit_all_image_verify(const void *fit)
 			 * Direct child node of the images parent node,
 			 * i.e. component image node.
 			 */
-			printf("   Hash(es) for Image %u (%s): ", count,
-			       fit_get_name(fit, noffset, NULL));
+			name = fit_get_name(fit, noffset, NULL);
+			printf("   Hash(es) for Image %u (%s): ", count, name);
 			count++;
 
-			if (!fit_image_verify(fit, noffset))
+			if (!fit_conf_uses_image(fit, conf_noffset, name)) {
+				printf("skipped, not used by '%s'\n",
+				       conf_name);
+				continue;
+			}
+
+			if (!fit_image_verify(fit, noffset)) {
+				fit_batch_hash_clear();
 				return 0;
+			}
 			printf("\n");
 		}
 	}
+	fit_batch_hash_clear();
+
 	return 1;
 }
 
+/**
+ * fit_all_image_verify - verify data integrity for all images
+ * @fit: pointer to the FIT format image header
+ *
+ * fit_all_image_verify() goes over all images in the FIT and
+ * for every images checks if all it's hashes are valid.
+ *
+ * returns:
+ *     1, if all hashes of all images are valid
+ *     0, otherwise (or on error)
+ */
+int fit_all_image_verify(const void *fit)
+{
+	return fit_conf_image_verify(fit, -1);
+}
+
 static int fit_image_uncipher(const void *fit, int image_noffset,
 			      void **data, size_t *size)
 {
@@ -2042,6 +2369,19 @@ static const char *fit_get_image_type_property(int type)
 	return "unknown";
 }
 
+/* Check if boot_ramdisk_high() would copy a ramdisk loaded to @load again */
+static bool fit_ramdisk_copied_again(struct bootm_headers *images,
+				     int image_type, ulong load, ulong len)
+{
+#ifndef USE_HOSTCC
+	if (IS_ENABLED(CONFIG_SYS_BOOT_RAMDISK_IN_PLACE) &&
+	    image_type == IH_TYPE_RAMDISK)
+		return !boot_ramdisk_in_place(images_lmb(images), load, len);
+#endif
+
+	return false;
+}
+
 int fit_image_load(struct bootm_headers *images, ulong addr,
 		   const char **fit_unamep, const char **fit_uname_configp,
 		   int arch, int ph_type, int bootstage_id,
@@ -2244,8 +2584,19 @@ int fit_image_load(struct bootm_headers *images, ulong addr,
 			return -EXDEV;
 		}
 
-		printf("   Loading %s from 0x%08lx to 0x%08lx\n",
-		       prop_name, data, load);
+		/*
+		 * boot_ramdisk_high() copies a ramdisk it cannot boot where it
+		 * is. Copying it to such a load address first only adds a
+		 * second copy, so leave it for that single one.
+		 */
+		if (fit_ramdisk_copied_again(images, image_type, load, len)) {
+			printf("   Leaving %s at 0x%08lx, 0x%08lx is not usable\n",
+			       prop_name, data, load);
+			load = data;
+		} else {
+			printf("   Loading %s from 0x%08lx to 0x%08lx\n",
+			       prop_name, data, load);
+		}
 	} else {
 		load = data;	/* No load address specified */
 	}
@@ -2274,7 +2625,9 @@ int fit_image_load(struct bootm_headers *images, ulong addr,
 		len = load_end - load;
 	} else if (load != data) {
 		loadbuf = map_sysmem(load, len);
+		bootstage_start(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, "image_copy");
 		memcpy(loadbuf, buf, len);
+		bootstage_accum_size(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, len);
 	}
 
 	if (image_type == IH_TYPE_RAMDISK && comp != IH_COMP_NONE)
@@ -54,6 +54,7 @@ DECLARE_GLOBAL_DATA_PTR;
 #endif /* !USE_HOSTCC*/
 
 #include <abuf.h>
+#include <bootstage.h>
 #include <bzlib.h>
 #include <display_options.h>
 #include <gzip.h>
@@ -443,10 +444,13 @@ int image_decomp(int comp, ulong load, ulong image_start, int type,
 		 void *load_buf, void *image_buf, ulong image_len,
 		 uint unc_len, ulong *load_end)
 {
+	bool moved = comp != IH_COMP_NONE || load != image_start;
 	int ret = -ENOSYS;
 
 	*load_end = load;
 	print_decomp_msg(comp, type, load == image_start);
+	if (moved)
+		bootstage_start(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, "image_copy");
 
 	/*
 	 * Load the image to the right place, decompressing if needed. After
@@ -527,6 +531,9 @@ int image_decomp(int comp, ulong load, ulong image_start, int type,
 	if (ret)
 		return ret;
 
+	/* count the bytes written, i.e. uncompressed */
+	if (moved)
+		bootstage_accum_size(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, image_len);
 	*load_end = load + image_len;
 
 	return 0;
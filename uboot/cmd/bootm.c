@@ -25,7 +25,7 @@
 DECLARE_GLOBAL_DATA_PTR;
 
 #if defined(CONFIG_CMD_IMI)
-static int image_info(unsigned long addr);
+static int image_info(unsigned long addr, bool all);
 #endif
 
 #if defined(CONFIG_CMD_IMLS)
@@ -325,20 +325,52 @@ static int do_iminfo(struct cmd_tbl *cmdtp, int flag, int argc,
 	int	arg;
 	ulong	addr;
 	int	rcode = 0;
+	bool	all = false;
+
+	if (argc > 1 && !strcmp(argv[1], "-a")) {
+		all = true;
+		argc--;
+		argv++;
+	}
 
 	if (argc < 2) {
-		return image_info(image_load_addr);
+		return image_info(image_load_addr, all);
 	}
 
 	for (arg = 1; arg < argc; ++arg) {
 		addr = hextoul(argv[arg], NULL);
-		if (image_info(addr) != 0)
+		if (image_info(addr, all) != 0)
 			rcode = 1;
 	}
 	return rcode;
 }
 
-static int image_info(ulong addr)
+#if defined(CONFIG_FIT)
+/*
+ * Check the images of the configuration bootm would pick, or all of them
+ * if asked to, or if no configuration can be found
+ */
+static int fit_info_verify(const void *fit, bool all)
+{
+	int conf_noffset = -1;
+
+	if (!IS_ENABLED(CONFIG_FIT_VERIFY_CONF_IMAGES))
+		return fit_all_image_verify(fit);
+
+	if (!all)
+		conf_noffset = fit_conf_get_node(fit, NULL);
+
+	if (conf_noffset >= 0)
+		printf("   Verifying images of configuration '%s' only (-a for all)\n",
+		       fit_get_name(fit, conf_noffset, NULL));
+	else
+		puts("   Verifying all images\n");
+
+	return fit_conf_image_verify(fit, conf_noffset);
+}
+#endif
+
+static int image_info(ulong addr, bool all)
 {
 	void *hdr = (void *)map_sysmem(addr, 0);
 
@@ -391,7 +423,7 @@ static int image_info(ulong addr)
 
 		fit_print_contents(hdr);
 
-		if (!fit_all_image_verify(hdr)) {
+		if (!fit_info_verify(hdr, all)) {
 			puts("Bad hash in FIT image!\n");
 			unmap_sysmem(hdr);
 			return 1;
@@ -412,10 +444,17 @@ static int image_info(ulong addr)
 U_BOOT_CMD(
 	iminfo,	CONFIG_SYS_MAXARGS,	1,	do_iminfo,
 	"print header information for application image",
+#if defined(CONFIG_FIT_VERIFY_CONF_IMAGES)
+	"[-a] "
+#endif
 	"addr [addr ...]\n"
 	"    - print header information for application image starting at\n"
 	"      address 'addr' in memory; this includes verification of the\n"
 	"      image contents (magic number, header and payload checksums)"
+#if defined(CONFIG_FIT_VERIFY_CONF_IMAGES)
+	"\n    -a: for a FIT, check all images rather than only those used by\n"
+	"        the configuration that would be booted"
+#endif
 );
 #endif
 
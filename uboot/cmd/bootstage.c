@@ -6,6 +6,9 @@
 #include <common.h>
 #include <bootstage.h>
 #include <command.h>
+#include <env.h>
+#include <malloc.h>
+#include <mapmem.h>
 
 static int do_bootstage_report(struct cmd_tbl *cmdtp, int flag, int argc,
 			       char *const argv[])
@@ -59,10 +62,65 @@ static int do_bootstage_stash(struct cmd_tbl *cmdtp, int flag, int argc,
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+static int do_bootstage_profile(struct cmd_tbl *cmdtp, int flag, int argc,
+				char *const argv[])
+{
+	bootstage_profile_report();
+
+	return 0;
+}
+
+static int do_bootstage_chrome(struct cmd_tbl *cmdtp, int flag, int argc,
+			       char *const argv[])
+{
+	ulong base, size;
+	char *buf;
+	int len;
+
+	len = bootstage_profile_chrome(NULL, 0);
+	if (len < 0) {
+		printf("No bootstage data (err=%d)\n", len);
+		return CMD_RET_FAILURE;
+	}
+
+	/* With no address, print the trace */
+	if (argc < 2) {
+		buf = malloc(len + 1);
+		if (!buf) {
+			printf("Out of memory\n");
+			return CMD_RET_FAILURE;
+		}
+		bootstage_profile_chrome(buf, len + 1);
+		puts(buf);
+		free(buf);
+
+		return 0;
+	}
+
+	base = hextoul(argv[1], NULL);
+	size = argc > 2 ? hextoul(argv[2], NULL) : len + 1;
+	if (size < len + 1) {
+		printf("Trace needs %#x bytes\n", len + 1);
+		return CMD_RET_FAILURE;
+	}
+	buf = map_sysmem(base, size);
+	bootstage_profile_chrome(buf, size);
+	unmap_sysmem(buf);
+	env_set_hex("filesize", len);
+
+	return 0;
+}
+#endif
+
 static struct cmd_tbl cmd_bootstage_sub[] = {
 	U_BOOT_CMD_MKENT(report, 2, 1, do_bootstage_report, "", ""),
 	U_BOOT_CMD_MKENT(stash, 4, 0, do_bootstage_stash, "", ""),
 	U_BOOT_CMD_MKENT(unstash, 4, 0, do_bootstage_stash, "", ""),
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+	U_BOOT_CMD_MKENT(profile, 2, 1, do_bootstage_profile, "", ""),
+	U_BOOT_CMD_MKENT(chrome, 4, 0, do_bootstage_chrome, "", ""),
+#endif
 };
 
 /*
@@ -93,4 +151,8 @@ U_BOOT_CMD(bootstage, 4, 1, do_boostage,
 	"report                      - Print a report\n"
 	"stash [<start> [<size>]]    - Stash data into memory\n"
 	"unstash [<start> [<size>]]  - Unstash data from memory"
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+	"\nprofile                     - Print initcall and probe times\n"
+	"chrome [<start> [<size>]]   - Print or write a Chrome trace"
+#endif
 );
@@ -22,7 +22,9 @@
 #endif
 #include <hash.h>
 #include <log.h>
+#include <malloc.h>
 #include <mapmem.h>
+#include <memtest.h>
 #include <rand.h>
 #include <watchdog.h>
 #include <asm/global_data.h>
@@ -31,6 +33,8 @@
 #include <linux/compiler.h>
 #include <linux/ctype.h>
 #include <linux/delay.h>
+#include <linux/math64.h>
+#include <linux/sizes.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -1060,6 +1064,72 @@ static ulong mem_test_quick(vu_long *buf, ulong start_addr, ulong end_addr,
 	return errs;
 }
 
+/*
+ * Test the range with one part on each CPU, all at once, then report the
+ * errors and throughput of each part
+ */
+static ulong mem_test_parallel(vu_long *buf, ulong start_addr, ulong end_addr,
+			       ulong pattern, int iteration)
+{
+	const int plen = 2 * sizeof(u64);
+	struct memtest_part *parts, *part;
+	struct memtest_fail *fail;
+	ulong skip, size, errs = 0;
+	int count, cpus, i, j;
+	u64 rate;
+
+	/* Split the range into whole cache lines, one part for each CPU */
+	skip = ALIGN(start_addr, MEMTEST_LINE) - start_addr;
+	size = end_addr - start_addr > skip ? end_addr - start_addr - skip : 0;
+	count = memtest_cpu_count();
+	if (size / count < MEMTEST_LINE)
+		count = 1;
+	size = ALIGN_DOWN(size / count, MEMTEST_LINE);
+	if (!size) {
+		printf("\nRange too small\n");
+		return -1UL;
+	}
+
+	parts = calloc(count, sizeof(*parts));
+	if (!parts) {
+		printf("\nOut of memory\n");
+		return -1UL;
+	}
+	for (i = 0; i < count; i++) {
+		part = &parts[i];
+		part->addr = start_addr + skip + i * size;
+		part->buf = (void *)buf + skip + i * size;
+		part->size = size;
+		part->seed = iteration & 1 ? ~(u64)pattern : pattern;
+	}
+	cpus = memtest_run(parts, count);
+
+	printf("Iteration: %6d (%d CPU%s)\n", iteration + 1, cpus,
+	       cpus == 1 ? "" : "s");
+	printf("Part  %-*s  %-*s  %8s  %8s\n", plen, "Start", plen, "End",
+	       "Errors", "MB/s");
+	for (i = 0; i < count; i++) {
+		part = &parts[i];
+		rate = part->ticks ? div64_u64(part->bytes * get_tbclk(),
+					       part->ticks * SZ_1M) : 0;
+		printf("%4d  %0*lx  %0*lx  %8lu  %8llu\n", i, plen, part->addr,
+		       plen, part->addr + part->size - 1, part->errs, rate);
+		for (j = 0; j < part->nfails; j++) {
+			fail = &part->fails[j];
+			printf("      Mem error @ 0x%0*lX: found %0*llX, expected %0*llX%s\n",
+			       plen, fail->addr, plen, fail->actual, plen,
+			       fail->expected, fail->actual == fail->expected ?
+			       " (intermittent)" : "");
+		}
+		if (part->errs > part->nfails)
+			printf("      ...\n");
+		errs += part->errs;
+	}
+	free(parts);
+
+	return errs;
+}
+
 /*
  * Perform a memory test. A more complete alternative test can be
  * configured using CONFIG_SYS_ALT_MEMTEST. The complete test loops until
@@ -1075,11 +1145,19 @@ static int do_mem_mtest(struct cmd_tbl *cmdtp, int flag, int argc,
 	ulong count = 0;
 	ulong errs = 0;	/* number of errors, or -1 if interrupted */
 	ulong pattern = 0;
+	bool parallel = false;
 	int iteration;
 
 	start = CONFIG_SYS_MEMTEST_START;
 	end = CONFIG_SYS_MEMTEST_END;
 
+	if (IS_ENABLED(CONFIG_CMD_MEMTEST_PARALLEL) && argc > 1 &&
+	    !strcmp(argv[1], "-p")) {
+		parallel = true;
+		argc--;
+		argv++;
+	}
+
 	if (argc > 1)
 		if (strict_strtoul(argv[1], 16, &start) < 0)
 			return CMD_RET_USAGE;
@@ -1116,7 +1194,10 @@ static int do_mem_mtest(struct cmd_tbl *cmdtp, int flag, int argc,
 
 		printf("Iteration: %6d\r", iteration + 1);
 		debug("\n");
-		if (IS_ENABLED(CONFIG_SYS_ALT_MEMTEST)) {
+		if (parallel) {
+			errs = mem_test_parallel(buf, start, end, pattern,
+						 iteration);
+		} else if (IS_ENABLED(CONFIG_SYS_ALT_MEMTEST)) {
 			errs = mem_test_alt(buf, start, end, dummy);
 			if (errs == -1UL)
 				break;
@@ -1417,9 +1498,13 @@ U_BOOT_CMD(
 
 #ifdef CONFIG_CMD_MEMTEST
 U_BOOT_CMD(
-	mtest,	5,	1,	do_mem_mtest,
+	mtest,	6,	1,	do_mem_mtest,
 	"simple RAM read/write test",
 	"[start [end [pattern [iterations]]]]"
+#ifdef CONFIG_CMD_MEMTEST_PARALLEL
+	"\nmtest -p [start [end [pattern [iterations]]]]\n"
+	"    - test a cache line at a time, on all CPUs at once"
+#endif
 );
 #endif	/* CONFIG_CMD_MEMTEST */
 
@@ -0,0 +1,460 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Measure the memory bandwidth and load latency
+ *
+ * The bandwidth of each test is measured with plain C loops, the memset() and
+ * memcpy() of this build and, on ARMv8, Advanced SIMD loads and stores. With
+ * -p the bandwidth tests run at once on all the CPUs 'mtest -p' can start,
+ * each on its own slice of the range.
+ */
+
+#include <common.h>
+#include <command.h>
+#include <console.h>
+#include <malloc.h>
+#include <mapmem.h>
+#include <membench.h>
+#include <memtest.h>
+#include <time.h>
+#include <vsprintf.h>
+#include <watchdog.h>
+#include <asm/io.h>
+#include <linux/compiler.h>
+#include <linux/kernel.h>
+#include <linux/math64.h>
+#include <linux/sizes.h>
+
+/* Number of runs of each test, of which the fastest is reported */
+#define MEMBENCH_RUNS		3
+
+/* Bytes each CPU handles in a run of a bandwidth test */
+#define MEMBENCH_RUN_BYTES	SZ_64M
+
+/* Loads timed for each working-set size, a multiple of 8 */
+#define MEMBENCH_LOADS		SZ_1M
+
+#define MEMBENCH_FILL		0x5a
+
+typedef void (*membench_fn)(void *dst, const void *src, ulong size);
+
+enum {
+	MEMBENCH_C,
+	MEMBENCH_ARCH,
+	MEMBENCH_SIMD,
+
+	MEMBENCH_VARIANTS,
+};
+
+/**
+ * struct membench_test - a bandwidth test
+ *
+ * @name: Name of the test
+ * @copy: true to copy the second half of the buffer to the first half, in
+ *	which case the bytes copied are counted
+ * @fn: Function for each variant, NULL if there is none
+ */
+struct membench_test {
+	const char *name;
+	bool copy;
+	membench_fn fn[MEMBENCH_VARIANTS];
+};
+
+/**
+ * struct membench_job - a run of a bandwidth test on one CPU
+ *
+ * @fn: Function to run
+ * @dst: Destination passed to @fn
+ * @src: Source passed to @fn
+ * @size: Size passed to @fn
+ * @passes: Number of times to call @fn
+ * @ticks: Time taken
+ * @ready: Set by the CPU once it waits for membench_go
+ * @done: Set by the CPU once @ticks is valid
+ */
+struct membench_job {
+	membench_fn fn;
+	void *dst;
+	const void *src;
+	ulong size;
+	ulong passes;
+	u64 ticks;
+	bool ready;
+	bool done;
+};
+
+static bool membench_go;
+static ulong membench_sink;
+
+/*
+ * The C variants are built without loop distribution, so that the compiler
+ * does not turn them into calls to memset() and memcpy()
+ */
+static void membench_c_read(void *dst, const void *src, ulong size)
+{
+	const ulong *p = src, *end = src + size;
+	ulong sum = 0;
+
+	for (; p < end; p += 8)
+		sum += p[0] + p[1] + p[2] + p[3] + p[4] + p[5] + p[6] + p[7];
+	WRITE_ONCE(membench_sink, sum);
+}
+
+static void membench_c_write(void *dst, const void *src, ulong size)
+{
+	ulong *p = dst, *end = dst + size;
+	ulong val = ~0UL / 0xff * MEMBENCH_FILL;
+
+	for (; p < end; p += 8) {
+		p[0] = val;
+		p[1] = val;
+		p[2] = val;
+		p[3] = val;
+		p[4] = val;
+		p[5] = val;
+		p[6] = val;
+		p[7] = val;
+	}
+}
+
+static void membench_c_copy(void *dst, const void *src, ulong size)
+{
+	const ulong *s = src;
+	ulong *d = dst, *end = dst + size;
+
+	for (; d < end; d += 8, s += 8) {
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = s[2];
+		d[3] = s[3];
+		d[4] = s[4];
+		d[5] = s[5];
+		d[6] = s[6];
+		d[7] = s[7];
+	}
+}
+
+static void membench_arch_set(void *dst, const void *src, ulong size)
+{
+	memset(dst, MEMBENCH_FILL, size);
+}
+
+static void membench_arch_copy(void *dst, const void *src, ulong size)
+{
+	memcpy(dst, src, size);
+}
+
+#define SIMD(fn)	(IS_ENABLED(CONFIG_ARM64) ? (fn) : NULL)
+
+static const struct membench_test membench_tests[] = {
+	{ "read", false,
+	  { membench_c_read, NULL, SIMD(membench_simd_read) } },
+	{ "write", false,
+	  { membench_c_write, NULL, SIMD(membench_simd_write) } },
+	{ "memset", false,
+	  { NULL, membench_arch_set, NULL } },
+	{ "memcpy", true,
+	  { membench_c_copy, membench_arch_copy, SIMD(membench_simd_copy) } },
+};
+
+static void membench_job_run(struct membench_job *job)
+{
+	u64 start;
+	ulong i;
+
+	start = get_ticks();
+	for (i = 0; i < job->passes; i++)
+		job->fn(job->dst, job->src, job->size);
+	job->ticks = get_ticks() - start;
+}
+
+/* Run a job on another CPU, once all of them are ready */
+static void membench_cpu(void *arg)
+{
+	struct membench_job *job = arg;
+
+	WRITE_ONCE(job->ready, true);
+	while (!READ_ONCE(membench_go))
+		;
+	membench_job_run(job);
+	/* Make the result visible before the boot CPU sees 'done' */
+	wmb();
+	WRITE_ONCE(job->done, true);
+}
+
+/* Start as many of the other CPUs as possible, returning the CPUs in use */
+static int membench_start(struct membench_job *jobs, int cpus)
+{
+	int i;
+
+	if (!IS_ENABLED(CONFIG_CMD_MEMTEST_PARALLEL))
+		return 1;
+
+	WRITE_ONCE(membench_go, false);
+	for (i = 1; i < cpus; i++) {
+		jobs[i].ready = false;
+		jobs[i].done = false;
+		if (memtest_cpu_call(i, membench_cpu, &jobs[i]))
+			break;
+	}
+	cpus = i;
+	for (i = 1; i < cpus; i++) {
+		while (!READ_ONCE(jobs[i].ready))
+			schedule();
+	}
+
+	return cpus;
+}
+
+/* Run the jobs at once, returning the number of CPUs which ran them */
+static int membench_run(struct membench_job *jobs, int cpus)
+{
+	int i;
+
+	cpus = membench_start(jobs, cpus);
+	WRITE_ONCE(membench_go, true);
+	membench_job_run(&jobs[0]);
+	for (i = 1; i < cpus; i++) {
+		while (!READ_ONCE(jobs[i].done))
+			schedule();
+	}
+	/* Read the results only after 'done' */
+	rmb();
+
+	return cpus;
+}
+
+/**
+ * membench_bandwidth() - measure the bandwidth of a test on some CPUs
+ *
+ * @jobs: One job for each CPU
+ * @cpus: Number of CPUs to use; updated to the fewest that ran
+ * @buf: Buffer to use
+ * @size: Size of @buf, enough for 2 cache lines for each CPU
+ * @copy: true if @fn copies, see struct membench_test
+ * @fn: Function to measure
+ * Return: the best rate in MB/s
+ */
+static u64 membench_bandwidth(struct membench_job *jobs, int *cpus, void *buf,
+			      ulong size, bool copy, membench_fn fn)
+{
+	ulong slice = ALIGN_DOWN(size / *cpus, 2 * MEMBENCH_LINE);
+	struct membench_job *job;
+	u64 bytes, ticks, rate, best = 0;
+	int run, i, n;
+
+	for (i = 0; i < *cpus; i++) {
+		job = &jobs[i];
+		job->fn = fn;
+		job->dst = buf + i * slice;
+		job->size = copy ? slice / 2 : slice;
+		job->src = copy ? job->dst + job->size : job->dst;
+		job->passes = max(MEMBENCH_RUN_BYTES / job->size, 1UL);
+	}
+
+	for (run = 0; run < MEMBENCH_RUNS; run++) {
+		n = membench_run(jobs, *cpus);
+		bytes = 0;
+		ticks = 0;
+		for (i = 0; i < n; i++) {
+			bytes += (u64)jobs[i].size * jobs[i].passes;
+			ticks = max(ticks, jobs[i].ticks);
+		}
+		rate = ticks ? div64_u64(bytes * get_tbclk(), ticks * SZ_1M) : 0;
+		best = max(best, rate);
+		*cpus = min(*cpus, n);
+	}
+
+	return best;
+}
+
+static ulong *membench_line(void *buf, ulong i)
+{
+	return buf + i * MEMBENCH_LINE;
+}
+
+static u32 membench_rand(u32 *state)
+{
+	u32 x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/* Follow the pointers from @start, @loads times, returning where they end */
+static noinline ulong membench_chase(void *start, ulong loads)
+{
+	void **p = start;
+
+	for (; loads; loads -= 8) {
+		p = *p;
+		p = *p;
+		p = *p;
+		p = *p;
+		p = *p;
+		p = *p;
+		p = *p;
+		p = *p;
+	}
+
+	return (ulong)p;
+}
+
+/**
+ * membench_latency() - measure the load latency over a working set
+ *
+ * The cache lines in the working set are linked into one random cycle, so
+ * that each load depends on the one before and cannot be prefetched.
+ *
+ * @buf: Buffer to use
+ * @size: Size of the working set, a multiple of MEMBENCH_LINE
+ * @seed: State of the random number generator
+ * Return: the best time per load in hundredths of a nanosecond
+ */
+static ulong membench_latency(void *buf, ulong size, u32 *seed)
+{
+	ulong n = size / MEMBENCH_LINE;
+	u64 start, ticks, best = ~0ULL;
+	ulong i, j;
+	int run;
+
+	/* Sattolo's algorithm, holding the permutation in the lines */
+	for (i = 0; i < n; i++)
+		*membench_line(buf, i) = i;
+	for (i = n - 1; i > 0; i--) {
+		j = membench_rand(seed) % i;
+		swap(*membench_line(buf, i), *membench_line(buf, j));
+	}
+	for (i = 0; i < n; i++)
+		*membench_line(buf, i) =
+			(ulong)membench_line(buf, *membench_line(buf, i));
+
+	/* Walk the cycle once so that as much of it is cached as can be */
+	WRITE_ONCE(membench_sink, membench_chase(buf, ALIGN(n, 8)));
+	for (run = 0; run < MEMBENCH_RUNS; run++) {
+		start = get_ticks();
+		WRITE_ONCE(membench_sink, membench_chase(buf, MEMBENCH_LOADS));
+		ticks = get_ticks() - start;
+		best = min(best, ticks);
+	}
+
+	return div64_u64(div64_u64(best * 1000000000ULL, get_tbclk()) * 100,
+			 MEMBENCH_LOADS);
+}
+
+static int do_membench(struct cmd_tbl *cmdtp, int flag, int argc,
+		       char *const argv[])
+{
+	u64 rates[ARRAY_SIZE(membench_tests)][MEMBENCH_VARIANTS];
+	ulong addr, size, skip, from = SZ_4K, to, ws, lat;
+	const struct membench_test *test;
+	struct membench_job *jobs;
+	int cpus = 1, ret = CMD_RET_FAILURE;
+	u32 seed = 1;
+	void *buf;
+	int i, j;
+
+	if (IS_ENABLED(CONFIG_CMD_MEMTEST_PARALLEL) && argc > 1 &&
+	    !strcmp(argv[1], "-p")) {
+		cpus = memtest_cpu_count();
+		argc--;
+		argv++;
+	}
+	if (argc < 3 || argc > 5)
+		return CMD_RET_USAGE;
+	if (strict_strtoul(argv[1], 16, &addr) < 0 ||
+	    strict_strtoul(argv[2], 16, &size) < 0)
+		return CMD_RET_USAGE;
+
+	/* Use whole cache lines */
+	skip = ALIGN(addr, MEMBENCH_LINE) - addr;
+	size = size > skip ? ALIGN_DOWN(size - skip, MEMBENCH_LINE) : 0;
+	addr += skip;
+	if (size < 2 * MEMBENCH_LINE) {
+		printf("Range too small\n");
+		return CMD_RET_FAILURE;
+	}
+	if (size / cpus < 2 * MEMBENCH_LINE)
+		cpus = 1;
+
+	to = size;
+	if (argc > 3 && strict_strtoul(argv[3], 16, &from) < 0)
+		return CMD_RET_USAGE;
+	if (argc > 4 && strict_strtoul(argv[4], 16, &to) < 0)
+		return CMD_RET_USAGE;
+	if (from < MEMBENCH_LINE || from > to || to > size)
+		return CMD_RET_USAGE;
+
+	jobs = calloc(cpus, sizeof(*jobs));
+	if (!jobs) {
+		printf("Out of memory\n");
+		return CMD_RET_FAILURE;
+	}
+
+	printf("Testing %08lx ... %08lx:\n", addr, addr + size - 1);
+	buf = map_sysmem(addr, size);
+	for (i = 0; i < ARRAY_SIZE(membench_tests); i++) {
+		test = &membench_tests[i];
+		for (j = 0; j < MEMBENCH_VARIANTS; j++) {
+			if (ctrlc())
+				goto abort;
+			if (test->fn[j])
+				rates[i][j] = membench_bandwidth(jobs, &cpus,
+								 buf, size,
+								 test->copy,
+								 test->fn[j]);
+		}
+	}
+
+	printf("Bandwidth in MB/s (%d CPU%s):\n", cpus, cpus == 1 ? "" : "s");
+	printf("%-6s  %8s  %8s  %8s\n", "Test", "C", "arch", "SIMD");
+	for (i = 0; i < ARRAY_SIZE(membench_tests); i++) {
+		test = &membench_tests[i];
+		printf("%-6s", test->name);
+		for (j = 0; j < MEMBENCH_VARIANTS; j++) {
+			if (test->fn[j])
+				printf("  %8llu", rates[i][j]);
+			else
+				printf("  %8s", "-");
+		}
+		printf("\n");
+	}
+
+	printf("Latency in ns per load:\n");
+	printf("%11s  %8s\n", "Working set", "ns");
+	for (ws = from; ws <= to; ws *= 2) {
+		if (ctrlc())
+			goto abort;
+		lat = membench_latency(buf, ALIGN_DOWN(ws, MEMBENCH_LINE),
+				       &seed);
+		printf("%11lx  %5lu.%02lu\n", ws, lat / 100, lat % 100);
+	}
+	ret = CMD_RET_SUCCESS;
+	goto out;
+
+abort:
+	printf("Abort\n");
+out:
+	unmap_sysmem(buf);
+	free(jobs);
+
+	return ret;
+}
+
+U_BOOT_CMD(
+	membench,	6,	0,	do_membench,
+	"measure memory bandwidth and latency",
+#ifdef CONFIG_CMD_MEMTEST_PARALLEL
+	"[-p] "
+#endif
+	"addr size [from [to]]\n"
+	"    - measure the read, write, memset and memcpy bandwidth over\n"
+	"      'size' bytes at 'addr', then the load latency over working sets\n"
+	"      doubling from 'from' (default 1000) up to 'to' (default 'size')"
+#ifdef CONFIG_CMD_MEMTEST_PARALLEL
+	"\n    -p: measure the bandwidth on all CPUs at once"
+#endif
+);
@@ -583,6 +583,28 @@ static int reserve_stacks(void)
 	return arch_reserve_stacks();
 }
 
+/*
+ * With CONFIG_SKIP_RELOCATE U-Boot stays where it was loaded, so make sure
+ * that the memory reserved above, and the stack below it, leave it alone
+ */
+static int check_skip_reloc(void)
+{
+	ulong start = (ulong)_start;
+
+	/* Sandbox runs from host memory, outside its emulated RAM */
+	if (!IS_ENABLED(CONFIG_SKIP_RELOCATE) || IS_ENABLED(CONFIG_SANDBOX) ||
+	    start >= gd->ram_top)
+		return 0;
+
+	if (start + gd->mon_len > gd->start_addr_sp - CONFIG_STACK_SIZE) {
+		printf("U-Boot at %08lx overlaps the memory reserved from %08lx\n",
+		       start, gd->start_addr_sp - CONFIG_STACK_SIZE);
+		return -ENOSPC;
+	}
+
+	return 0;
+}
+
 static int reserve_bloblist(void)
 {
 #ifdef CONFIG_BLOBLIST
@@ -630,10 +652,21 @@ static int init_post(void)
 }
 #endif
 
+/*
+ * Check whether data set up before relocation can stay where it is. With
+ * CONFIG_SKIP_RELOCATE only the code stays: the devicetree may sit in what
+ * becomes the BSS and the early malloc() area is not reserved afterwards.
+ */
+static bool skip_data_reloc(void)
+{
+	return (gd->flags & GD_FLG_SKIP_RELOC) &&
+	       !IS_ENABLED(CONFIG_SKIP_RELOCATE);
+}
+
 static int reloc_fdt(void)
 {
 	if (!IS_ENABLED(CONFIG_OF_EMBED)) {
-		if (gd->flags & GD_FLG_SKIP_RELOC)
+		if (skip_data_reloc())
 			return 0;
 		if (gd->new_fdt) {
 			memcpy(gd->new_fdt, gd->fdt_blob,
@@ -648,7 +681,7 @@ static int reloc_fdt(void)
 static int reloc_bootstage(void)
 {
 #ifdef CONFIG_BOOTSTAGE
-	if (gd->flags & GD_FLG_SKIP_RELOC)
+	if (skip_data_reloc())
 		return 0;
 	if (gd->new_bootstage) {
 		int size = bootstage_get_size();
@@ -670,7 +703,7 @@ static int reloc_bloblist(void)
 	/*
 	 * Relocate only if we are supposed to send it
 	 */
-	if ((gd->flags & GD_FLG_SKIP_RELOC) &&
+	if (skip_data_reloc() &&
 	    CONFIG_BLOBLIST_SIZE == CONFIG_BLOBLIST_SIZE_RELOC) {
 		debug("Not relocating bloblist\n");
 		return 0;
@@ -946,6 +979,7 @@ static const init_fnc_t init_sequence_f[] = {
 	reserve_bloblist,
 	reserve_arch,
 	reserve_stacks,
+	check_skip_reloc,
 	dram_init_banksize,
 	show_dram_config,
 	INIT_FUNC_WATCHDOG_RESET
@@ -981,6 +1015,8 @@ static const init_fnc_t init_sequence_f[] = {
 void board_init_f(ulong boot_flags)
 {
 	gd->flags = boot_flags;
+	if (IS_ENABLED(CONFIG_SKIP_RELOCATE))
+		gd->flags |= GD_FLG_SKIP_RELOC;
 	gd->have_console = 0;
 
 	if (initcall_run_list(init_sequence_f))
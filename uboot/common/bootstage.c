@@ -34,12 +34,45 @@ struct bootstage_record {
 	const char *name;
 	int flags;		/* see enum bootstage_flags */
 	enum bootstage_id id;
+	ulong size;		/* bytes handled, see bootstage_accum_size() */
 };
 
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+enum {
+	SPAN_COUNT	= CONFIG_BOOTSTAGE_PROFILE_COUNT,
+	SPAN_NAME_LEN	= 21,
+};
+
+/* Flags for each span */
+enum bootstage_span_flags {
+	BOOTSTAGE_SPANF_DONE	= 1 << 0,	/* Span has ended */
+};
+
+/*
+ * A span of the boot, such as an initcall or a device probe. The name is
+ * held in the record since it may point into the devicetree, which moves
+ * on relocation.
+ */
+struct bootstage_span {
+	u32 start_us;
+	u32 time_us;
+	u8 type;		/* enum bootstage_span_type */
+	u8 depth;		/* Number of spans this one is inside */
+	u8 flags;		/* enum bootstage_span_flags */
+	char name[SPAN_NAME_LEN];
+};
+#endif
+
 struct bootstage_data {
 	uint rec_count;
 	uint next_id;
 	struct bootstage_record record[RECORD_COUNT];
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+	uint span_count;	/* Number of spans recorded */
+	uint span_lost;		/* Number of spans not recorded for lack of space */
+	uint span_depth;	/* Number of spans currently running */
+	struct bootstage_span span[SPAN_COUNT];
+#endif
 };
 
 enum {
@@ -218,6 +251,71 @@ uint32_t bootstage_accum(enum bootstage_id id)
 	return duration;
 }
 
+uint32_t bootstage_accum_size(enum bootstage_id id, ulong size)
+{
+	struct bootstage_data *data = gd->bootstage;
+	struct bootstage_record *rec = ensure_id(data, id);
+
+	if (rec)
+		rec->size += size;
+
+	return bootstage_accum(id);
+}
+
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+int bootstage_span_start(enum bootstage_span_type type, const char *name)
+{
+	struct bootstage_data *data = gd->bootstage;
+	struct bootstage_span *span;
+	int num;
+
+	if (!data)
+		return -1;
+
+	/* Keep counting the depth when full, so that the end matches */
+	num = data->span_count;
+	if (num < SPAN_COUNT) {
+		span = &data->span[data->span_count++];
+		span->start_us = timer_get_boot_us();
+		span->time_us = 0;
+		span->type = type;
+		span->depth = data->span_depth;
+		span->flags = 0;
+		strlcpy(span->name, name, sizeof(span->name));
+	} else {
+		data->span_lost++;
+	}
+	data->span_depth++;
+
+	return num;
+}
+
+int bootstage_span_start_addr(enum bootstage_span_type type, ulong addr)
+{
+	char name[SPAN_NAME_LEN];
+
+	snprintf(name, sizeof(name), "%lx", addr);
+
+	return bootstage_span_start(type, name);
+}
+
+void bootstage_span_end(int num)
+{
+	struct bootstage_data *data = gd->bootstage;
+	struct bootstage_span *span;
+
+	if (num < 0 || !data)
+		return;
+
+	data->span_depth--;
+	if (num < data->span_count) {
+		span = &data->span[num];
+		span->time_us = (u32)timer_get_boot_us() - span->start_us;
+		span->flags |= BOOTSTAGE_SPANF_DONE;
+	}
+}
+#endif
+
 /**
  * Get a record name as a printable string
  *
@@ -250,7 +348,10 @@ static uint32_t print_time_record(struct bootstage_record *rec, uint32_t prev)
 		print_grouped_ull(rec->time_us, BOOTSTAGE_DIGITS);
 		print_grouped_ull(rec->time_us - prev, BOOTSTAGE_DIGITS);
 	}
-	printf("  %s\n", get_record_name(buf, sizeof(buf), rec));
+	printf("  %s", get_record_name(buf, sizeof(buf), rec));
+	if (rec->size)
+		printf(" (%lu bytes)", rec->size);
+	printf("\n");
 
 	return rec->time_us;
 }
@@ -381,6 +482,150 @@ static void append_data(char **ptrp, char *end, const void *data, int size)
 	memcpy(ptr, data, size);
 }
 
+#if CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+static const char *const span_type_name[BOOTSTAGE_SPAN_TYPE_COUNT] = {
+	"initcall",
+	"probe",
+	"post_probe",
+};
+
+/* Get the time taken by a span, up to @now if it has not ended */
+static u32 span_time(const struct bootstage_span *span, u32 now)
+{
+	if (span->flags & BOOTSTAGE_SPANF_DONE)
+		return span->time_us;
+
+	return now - span->start_us;
+}
+
+/* Get the time taken by a span less the time taken by the spans inside it */
+static u32 span_self_time(const struct bootstage_data *data, uint num,
+			  u32 now)
+{
+	const struct bootstage_span *span = &data->span[num];
+	const struct bootstage_span *child;
+	u32 time = span_time(span, now);
+	u32 children = 0;
+	uint i;
+
+	for (i = num + 1; i < data->span_count; i++) {
+		child = &data->span[i];
+		if (child->depth <= span->depth)
+			break;
+		if (child->depth == span->depth + 1)
+			children += span_time(child, now);
+	}
+
+	return children < time ? time - children : 0;
+}
+
+void bootstage_profile_report(void)
+{
+	struct bootstage_data *data = gd->bootstage;
+	const struct bootstage_span *span;
+	u32 now = timer_get_boot_us();
+	uint i;
+
+	printf("Profile in microseconds (%d spans):\n", data->span_count);
+	printf("%11s%11s%11s  %-10s  %s\n", "Start", "Time", "Self", "Type",
+	       "Name");
+	for (i = 0, span = data->span; i < data->span_count; i++, span++) {
+		print_grouped_ull(span->start_us, BOOTSTAGE_DIGITS);
+		print_grouped_ull(span_time(span, now), BOOTSTAGE_DIGITS);
+		print_grouped_ull(span_self_time(data, i, now),
+				  BOOTSTAGE_DIGITS);
+		printf("  %-10s  %*s%s%s\n", span_type_name[span->type],
+		       span->depth * 2, "", span->name,
+		       span->flags & BOOTSTAGE_SPANF_DONE ? "" : " (running)");
+	}
+	if (data->span_lost)
+		printf("Lost %u spans\n"
+		       "Please increase CONFIG_BOOTSTAGE_PROFILE_COUNT\n",
+		       data->span_lost);
+}
+
+static void append_str(char **ptrp, char *end, const char *str)
+{
+	append_data(ptrp, end, str, strlen(str));
+}
+
+/* Append a JSON string, escaping quotes and backslashes */
+static void append_json_str(char **ptrp, char *end, const char *str)
+{
+	append_data(ptrp, end, "\"", 1);
+	for (; *str; str++) {
+		if (*str == '"' || *str == '\\')
+			append_data(ptrp, end, "\\", 1);
+		append_data(ptrp, end, str, 1);
+	}
+	append_data(ptrp, end, "\"", 1);
+}
+
+/* Append a trace event, a complete event if @dur is given, else an instant */
+static void append_event(char **ptrp, char *end, bool *firstp,
+			 const char *name, const char *cat, u32 ts,
+			 const u32 *dur)
+{
+	char str[80];
+
+	if (!*firstp)
+		append_str(ptrp, end, ",");
+	*firstp = false;
+
+	append_str(ptrp, end, "\n{\"name\":");
+	append_json_str(ptrp, end, name);
+	if (dur)
+		snprintf(str, sizeof(str),
+			 ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%u,\"dur\":%u",
+			 cat, ts, *dur);
+	else
+		snprintf(str, sizeof(str),
+			 ",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%u",
+			 cat, ts);
+	append_str(ptrp, end, str);
+	append_str(ptrp, end, ",\"pid\":0,\"tid\":0}");
+}
+
+int bootstage_profile_chrome(char *buf, int size)
+{
+	struct bootstage_data *data = gd->bootstage;
+	const struct bootstage_record *rec;
+	const struct bootstage_span *span;
+	char *ptr = buf, *end = buf + size;
+	u32 now = timer_get_boot_us();
+	bool first = true;
+	char name[20];
+	u32 dur;
+	uint i;
+
+	if (!data)
+		return -ENOENT;
+
+	append_str(&ptr, end, "{\"traceEvents\":[");
+	for (i = 0, rec = data->record; i < data->rec_count; i++, rec++) {
+		/* An accumulated record has no single time to show */
+		if (rec->start_us)
+			continue;
+		append_event(&ptr, end, &first,
+			     get_record_name(name, sizeof(name), rec),
+			     "bootstage", rec->time_us, NULL);
+	}
+	for (i = 0, span = data->span; i < data->span_count; i++, span++) {
+		dur = span_time(span, now);
+		append_event(&ptr, end, &first, span->name,
+			     span_type_name[span->type], span->start_us, &dur);
+	}
+	append_str(&ptr, end, "\n]}\n");
+
+	if (ptr < end)
+		*ptr = '\0';
+	else if (size)
+		end[-1] = '\0';
+
+	return ptr - buf;
+}
+#endif
+
 int bootstage_stash(void *base, int size)
 {
 	const struct bootstage_data *data = gd->bootstage;
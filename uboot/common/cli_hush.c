@@ -332,6 +332,8 @@ struct in_str {
 	int promptmode;
 #ifndef __U_BOOT__
 	FILE *file;
+#else
+	const char *cache_text;		/* key for the parse cache, or NULL */
 #endif
 	int (*get) (struct in_str *);
 	int (*peek) (struct in_str *);
@@ -1158,6 +1160,8 @@ static void setup_file_in_str(struct in_str *i)
 	i->promptmode=1;
 #ifndef __U_BOOT__
 	i->file = f;
+#else
+	i->cache_text = NULL;
 #endif
 	i->p = NULL;
 }
@@ -1169,6 +1173,9 @@ static void setup_string_in_str(struct in_str *i, const char *s)
 	i->__promptme=1;
 	i->promptmode=1;
 	i->p = s;
+#ifdef __U_BOOT__
+	i->cache_text = NULL;
+#endif
 }
 
 #ifndef __U_BOOT__
@@ -3168,6 +3175,145 @@ static void update_ifs_map(void)
 	mapset(ifs, 2);            /* also flow through if quoted */
 }
 
+#ifdef CONFIG_HUSH_PARSE_CACHE
+/*
+ * Cache of parsed command strings. Running a pipe list changes it (for
+ * loops and assignments do) and frees it, so each run is given a copy.
+ */
+struct parse_cache_entry {
+	char *text;
+	int len;
+	int flag;
+	ulong used;
+	struct pipe *list;
+};
+
+static struct parse_cache_entry parse_cache[CONFIG_HUSH_PARSE_CACHE_SIZE];
+static ulong parse_cache_clock;
+
+static struct pipe *clone_pipe_list(const struct pipe *head)
+{
+	struct pipe *list = NULL, **nextp = &list, *pi;
+	struct child_prog *child;
+	const struct pipe *src;
+	int i, a;
+
+	for (src = head; src; src = src->next) {
+		pi = xmalloc(sizeof(*pi));
+		*pi = *src;
+		pi->next = NULL;
+		/* as in done_command(), there is a spare child at the end */
+		pi->progs = xmalloc(sizeof(*pi->progs) * (src->num_progs + 1));
+		memcpy(pi->progs, src->progs,
+		       sizeof(*pi->progs) * (src->num_progs + 1));
+		for (i = 0; i < src->num_progs; i++) {
+			child = &pi->progs[i];
+			if (child->argv) {
+				child->argv = xmalloc(sizeof(*child->argv) *
+						      (child->argc + 1));
+				child->argv_nonnull = xmalloc(
+					sizeof(*child->argv_nonnull) *
+					(child->argc + 1));
+				for (a = 0; a < child->argc; a++)
+					child->argv[a] =
+						xstrdup(src->progs[i].argv[a]);
+				child->argv[a] = NULL;
+				memcpy(child->argv_nonnull,
+				       src->progs[i].argv_nonnull,
+				       sizeof(*child->argv_nonnull) *
+				       (child->argc + 1));
+			} else if (child->group) {
+				child->group = clone_pipe_list(child->group);
+			}
+		}
+		*nextp = pi;
+		nextp = &pi->next;
+	}
+
+	return list;
+}
+
+static bool parse_cache_usable(int flag)
+{
+	/*
+	 * A reparsed command is the text left after substituting variables,
+	 * which is seldom seen twice. Parsing depends on IFS, which is
+	 * normally not set.
+	 */
+	return !(flag & FLAG_REPARSING) && (gd->flags & GD_FLG_RELOC) &&
+	       !env_get("IFS");
+}
+
+static struct parse_cache_entry *parse_cache_find(const char *text, int flag)
+{
+	struct parse_cache_entry *e;
+	int len = strlen(text);
+
+	for (e = parse_cache; e < parse_cache + ARRAY_SIZE(parse_cache); e++) {
+		if (e->text && e->flag == flag && e->len == len &&
+		    !memcmp(e->text, text, len)) {
+			e->used = ++parse_cache_clock;
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+/* Keep a copy of a pipe list parsed from the whole of @text */
+static void parse_cache_add(const char *text, int flag, struct pipe *list)
+{
+	struct parse_cache_entry *e, *lru = parse_cache;
+
+	if (!parse_cache_usable(flag))
+		return;
+	for (e = parse_cache; e < parse_cache + ARRAY_SIZE(parse_cache); e++) {
+		if (e->used < lru->used)
+			lru = e;
+	}
+	if (lru->text) {
+		free(lru->text);
+		free_pipe_list(lru->list, 0);
+	}
+
+	lru->text = strdup(text);
+	if (!lru->text) {
+		lru->used = 0;
+		return;
+	}
+	lru->len = strlen(text);
+	lru->flag = flag;
+	lru->used = ++parse_cache_clock;
+	lru->list = clone_pipe_list(list);
+}
+
+/* Run a command string from the cache, as parse_stream_outer() would */
+static bool parse_cache_run(const char *text, int flag, int *rcodep)
+{
+	struct parse_cache_entry *e;
+	int code;
+
+	if (!parse_cache_usable(flag))
+		return false;
+	e = parse_cache_find(text, flag);
+	if (!e)
+		return false;
+
+	update_ifs_map();
+	if (!(flag & FLAG_PARSE_SEMICOLON))
+		mapset((uchar *)";$&|", 0);
+	code = run_list(clone_pipe_list(e->list));
+	if (code == -1)
+		flag_repeat = 0;
+	*rcodep = code == -2 ? -2 : code != 0;
+
+	return true;
+}
+#else
+static inline void parse_cache_add(const char *text, int flag,
+				   struct pipe *list) {}
+#endif
+
 /* most recursion does not come through here, the exeception is
  * from builtin_source() */
 static int parse_stream_outer(struct in_str *inp, int flag)
@@ -3202,6 +3348,11 @@ static int parse_stream_outer(struct in_str *inp, int flag)
 #ifndef __U_BOOT__
 			run_list(ctx.list_head);
 #else
+			/* Cache the list if it holds the whole input */
+			if (inp->cache_text &&
+			    (rcode == -1 || !b_peek(inp)))
+				parse_cache_add(inp->cache_text, flag,
+						ctx.list_head);
 			code = run_list(ctx.list_head);
 			if (code == -2) {	/* exit */
 				b_free(&temp);
@@ -3239,6 +3390,9 @@ static int parse_stream_outer(struct in_str *inp, int flag)
 			free_pipe_list(ctx.list_head,0);
 		}
 		b_free(&temp);
+#ifdef __U_BOOT__
+		inp->cache_text = NULL;
+#endif
 	/* loop on syntax errors, return on EOF */
 	} while (rcode != -1 && !(flag & FLAG_EXIT_FROM_LOOP) &&
 		(inp->peek != static_peek || b_peek(inp)));
@@ -3263,17 +3417,25 @@ int parse_string_outer(const char *s, int flag)
 		return 1;
 	if (!*s)
 		return 0;
+#ifdef CONFIG_HUSH_PARSE_CACHE
+	if (parse_cache_run(s, flag, &rcode))
+		return rcode == -2 ? last_return_code : rcode;
+#endif
 	if (!(p = strchr(s, '\n')) || *++p) {
 		p = xmalloc(strlen(s) + 2);
 		strcpy(p, s);
 		strcat(p, "\n");
 		setup_string_in_str(&input, p);
+		input.cache_text = s;
 		rcode = parse_stream_outer(&input, flag);
 		free(p);
 		return rcode == -2 ? last_return_code : rcode;
 	} else {
 #endif
 	setup_string_in_str(&input, s);
+#ifdef __U_BOOT__
+	input.cache_text = s;
+#endif
 	rcode = parse_stream_outer(&input, flag);
 	return rcode == -2 ? last_return_code : rcode;
 #ifdef __U_BOOT__
@@ -15,9 +15,11 @@
 #include <env.h>
 #include <image.h>
 #include <log.h>
+#include <malloc.h>
 #include <mapmem.h>
 #include <asm/global_data.h>
 #include <linux/ctype.h>
+#include <linux/log2.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -89,6 +91,83 @@ int _do_help(struct cmd_tbl *cmd_start, int cmd_items, struct cmd_tbl *cmdtp,
 	return rcode;
 }
 
+#ifdef CONFIG_CMDLINE_HASH
+/*
+ * Hash table of the command names in the linker list, with linear probing.
+ * Each slot holds the index of a command plus one, or 0 if empty. It is
+ * built on first use after relocation, so that it lives in BSS and malloc()
+ * space which stay put.
+ */
+static u16 *cmd_hash;
+static uint cmd_hash_mask;
+
+static uint cmd_hash_name(const char *name, int len)
+{
+	uint hash = 2166136261U;	/* FNV-1a */
+
+	while (len--) {
+		hash ^= (uchar)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static int cmd_hash_build(struct cmd_tbl *table, int table_len)
+{
+	uint size, slot;
+	u16 idx;
+	int i;
+
+	if (table_len >= U16_MAX)
+		return -E2BIG;
+	size = roundup_pow_of_two(table_len * 2);
+	cmd_hash = calloc(size, sizeof(*cmd_hash));
+	if (!cmd_hash)
+		return -ENOMEM;
+	cmd_hash_mask = size - 1;
+
+	for (i = 0; i < table_len; i++) {
+		slot = cmd_hash_name(table[i].name, strlen(table[i].name));
+		for (slot &= cmd_hash_mask; (idx = cmd_hash[slot]);
+		     slot = (slot + 1) & cmd_hash_mask) {
+			/* Keep the first of two commands with the same name */
+			if (!strcmp(table[idx - 1].name, table[i].name))
+				break;
+		}
+		if (!idx)
+			cmd_hash[slot] = i + 1;
+	}
+
+	return 0;
+}
+
+/* Find the command called exactly @len characters of @cmd */
+static struct cmd_tbl *cmd_hash_find(const char *cmd, int len,
+				     struct cmd_tbl *table, int table_len)
+{
+	struct cmd_tbl *cmdtp;
+	uint slot;
+	u16 idx;
+
+	if (table != ll_entry_start(struct cmd_tbl, cmd) ||
+	    !(gd->flags & GD_FLG_RELOC))
+		return NULL;
+	if (!cmd_hash && cmd_hash_build(table, table_len))
+		return NULL;
+
+	slot = cmd_hash_name(cmd, len);
+	for (slot &= cmd_hash_mask; (idx = cmd_hash[slot]);
+	     slot = (slot + 1) & cmd_hash_mask) {
+		cmdtp = &table[idx - 1];
+		if (!strncmp(cmd, cmdtp->name, len) && !cmdtp->name[len])
+			return cmdtp;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_CMDLINE_HASH */
+
 /* find command table entry for a command */
 struct cmd_tbl *find_cmd_tbl(const char *cmd, struct cmd_tbl *table,
 			     int table_len)
@@ -108,6 +187,13 @@ struct cmd_tbl *find_cmd_tbl(const char *cmd, struct cmd_tbl *table,
 	 */
 	len = ((p = strchr(cmd, '.')) == NULL) ? strlen (cmd) : (p - cmd);
 
+#ifdef CONFIG_CMDLINE_HASH
+	/* Look up the full name first, then fall back to abbreviations */
+	cmdtp = cmd_hash_find(cmd, len, table, table_len);
+	if (cmdtp)
+		return cmdtp;
+#endif
+
 	for (cmdtp = table; cmdtp != table + table_len; cmdtp++) {
 		if (strncmp(cmd, cmdtp->name, len) == 0) {
 			if (len == strlen(cmdtp->name))
@@ -0,0 +1,316 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Memory test engine for 'mtest -p'
+ *
+ * The range is split into one part per CPU. Each part is tested a cache line
+ * at a time, with address-in-address, walking ones and moving inversions
+ * patterns. Architectures can provide faster test primitives and a way to
+ * start the other CPUs; otherwise the parts are tested one after another.
+ */
+
+#include <common.h>
+#include <memtest.h>
+#include <time.h>
+#include <watchdog.h>
+#include <asm/io.h>
+#include <linux/sizes.h>
+
+/* Amount tested between calls to schedule() */
+#define MEMTEST_STEP	SZ_1M
+
+enum memtest_op {
+	MEMTEST_FILL,
+	MEMTEST_CHECK,
+	MEMTEST_INV_UP,
+	MEMTEST_INV_DOWN,
+};
+
+__weak void memtest_fill(void *buf, ulong size, const u64 *line, u64 incr)
+{
+	u64 val[MEMTEST_LINE_WORDS];
+	u64 *ptr = buf;
+	int i;
+
+	memcpy(val, line, sizeof(val));
+	for (; size; size -= MEMTEST_LINE) {
+		for (i = 0; i < MEMTEST_LINE_WORDS; i++) {
+			*ptr++ = val[i];
+			val[i] += incr;
+		}
+	}
+}
+
+__weak ulong memtest_check(const void *buf, ulong size, const u64 *line,
+			   u64 incr)
+{
+	u64 val[MEMTEST_LINE_WORDS];
+	const u64 *ptr = buf;
+	ulong off;
+	u64 diff;
+	int i;
+
+	memcpy(val, line, sizeof(val));
+	for (off = 0; off < size; off += MEMTEST_LINE) {
+		for (diff = 0, i = 0; i < MEMTEST_LINE_WORDS; i++) {
+			diff |= *ptr++ ^ val[i];
+			val[i] += incr;
+		}
+		if (diff)
+			break;
+	}
+
+	return off;
+}
+
+__weak ulong memtest_inv_up(void *buf, ulong size, const u64 *line)
+{
+	u64 *ptr = buf;
+	ulong off;
+	u64 diff;
+	int i;
+
+	for (off = 0; off < size; off += MEMTEST_LINE, ptr += i) {
+		for (diff = 0, i = 0; i < MEMTEST_LINE_WORDS; i++)
+			diff |= ptr[i] ^ line[i];
+		if (diff)
+			break;
+		for (i = 0; i < MEMTEST_LINE_WORDS; i++)
+			ptr[i] = ~line[i];
+	}
+
+	return off;
+}
+
+__weak ulong memtest_inv_down(void *buf, ulong size, const u64 *line)
+{
+	u64 *ptr;
+	ulong off;
+	u64 diff;
+	int i;
+
+	for (off = size; off; ) {
+		off -= MEMTEST_LINE;
+		ptr = buf + off;
+		for (diff = 0, i = 0; i < MEMTEST_LINE_WORDS; i++)
+			diff |= ptr[i] ^ ~line[i];
+		if (diff)
+			return off;
+		for (i = 0; i < MEMTEST_LINE_WORDS; i++)
+			ptr[i] = line[i];
+	}
+
+	return size;
+}
+
+__weak int memtest_cpu_count(void)
+{
+	return 1;
+}
+
+__weak int memtest_cpu_call(int cpu, void (*func)(void *arg), void *arg)
+{
+	return -ENOSYS;
+}
+
+__weak void memtest_cpu_wait(int cpu, struct memtest_part *part)
+{
+}
+
+/* Work out the values of the line at @off, given those of the first line */
+static void memtest_line_at(u64 *out, const u64 *line, u64 incr, ulong off)
+{
+	u64 add = off / MEMTEST_LINE * incr;
+	int i;
+
+	for (i = 0; i < MEMTEST_LINE_WORDS; i++)
+		out[i] = line[i] + add;
+}
+
+/* Record the errors in a bad line and write @after to it */
+static void memtest_fail_line(struct memtest_part *part, ulong off,
+			      const u64 *expect, const u64 *after)
+{
+	volatile u64 *ptr = part->buf + off;
+	struct memtest_fail *fail;
+	ulong errs = part->errs;
+	u64 val;
+	int i;
+
+	for (i = 0; i < MEMTEST_LINE_WORDS; i++) {
+		val = ptr[i];
+		if (val != expect[i] || (i == MEMTEST_LINE_WORDS - 1 &&
+					 errs == part->errs)) {
+			if (part->nfails < MEMTEST_MAX_FAILS) {
+				fail = &part->fails[part->nfails++];
+				fail->addr = part->addr + off + i * sizeof(u64);
+				fail->expected = expect[i];
+				fail->actual = val;
+			}
+			part->errs++;
+		}
+		ptr[i] = after[i];
+	}
+}
+
+/* Run an operation over @size bytes at offset @off, carrying on past errors */
+static void memtest_op(struct memtest_part *part, enum memtest_op op,
+		       ulong off, ulong size, const u64 *line, u64 incr)
+{
+	u64 first[MEMTEST_LINE_WORDS], expect[MEMTEST_LINE_WORDS];
+	u64 after[MEMTEST_LINE_WORDS];
+	int accesses = op >= MEMTEST_INV_UP ? 2 : 1;
+	ulong bad;
+	int i;
+
+	while (size) {
+		memtest_line_at(first, line, incr, off);
+		switch (op) {
+		case MEMTEST_FILL:
+			memtest_fill(part->buf + off, size, first, incr);
+			part->bytes += size;
+			return;
+		case MEMTEST_CHECK:
+			bad = memtest_check(part->buf + off, size, first, incr);
+			break;
+		case MEMTEST_INV_UP:
+			bad = memtest_inv_up(part->buf + off, size, line);
+			break;
+		case MEMTEST_INV_DOWN:
+		default:
+			bad = memtest_inv_down(part->buf + off, size, line);
+			break;
+		}
+		if (bad == size) {
+			part->bytes += size * accesses;
+			return;
+		}
+
+		memtest_line_at(expect, line, incr, off + bad);
+		for (i = 0; i < MEMTEST_LINE_WORDS; i++) {
+			if (op == MEMTEST_INV_DOWN)
+				expect[i] = ~expect[i];
+			after[i] = op == MEMTEST_CHECK ? expect[i] : ~expect[i];
+		}
+		memtest_fail_line(part, off + bad, expect, after);
+
+		if (op == MEMTEST_INV_DOWN) {
+			part->bytes += (size - bad) * accesses;
+			size = bad;
+		} else {
+			part->bytes += (bad + MEMTEST_LINE) * accesses;
+			off += bad + MEMTEST_LINE;
+			size -= bad + MEMTEST_LINE;
+		}
+	}
+}
+
+/* Run an operation over the whole part, in steps */
+static void memtest_pass(struct memtest_part *part, enum memtest_op op,
+			 const u64 *line, u64 incr)
+{
+	ulong off, size;
+
+	if (op == MEMTEST_INV_DOWN) {
+		for (off = part->size; off; off -= size) {
+			size = min_t(ulong, off, MEMTEST_STEP);
+			memtest_op(part, op, off - size, size, line, incr);
+			if (part->local)
+				schedule();
+		}
+	} else {
+		for (off = 0; off < part->size; off += size) {
+			size = min_t(ulong, part->size - off, MEMTEST_STEP);
+			memtest_op(part, op, off, size, line, incr);
+			if (part->local)
+				schedule();
+		}
+	}
+}
+
+void memtest_part(struct memtest_part *part)
+{
+	u64 line[MEMTEST_LINE_WORDS];
+	u64 start;
+	int i, j;
+
+	part->errs = 0;
+	part->nfails = 0;
+	part->bytes = 0;
+	start = get_ticks();
+
+	/* Address in address, to find address lines which are stuck or shorted */
+	for (i = 0; i < MEMTEST_LINE_WORDS; i++)
+		line[i] = part->addr + i * sizeof(u64);
+	memtest_pass(part, MEMTEST_FILL, line, MEMTEST_LINE);
+	memtest_pass(part, MEMTEST_CHECK, line, MEMTEST_LINE);
+
+	/*
+	 * Walking ones and zeros in alternate words, so that each bit of the
+	 * line is walked across the passes
+	 */
+	for (j = 0; j < 64 / MEMTEST_LINE_WORDS; j++) {
+		for (i = 0; i < MEMTEST_LINE_WORDS; i++) {
+			line[i] = 1ULL << (j * MEMTEST_LINE_WORDS + i);
+			if (i & 1)
+				line[i] = ~line[i];
+		}
+		memtest_pass(part, MEMTEST_FILL, line, 0);
+		memtest_pass(part, MEMTEST_CHECK, line, 0);
+	}
+
+	/* Moving inversions, to find cells disturbed by their neighbours */
+	for (i = 0; i < MEMTEST_LINE_WORDS; i++)
+		line[i] = part->seed;
+	memtest_pass(part, MEMTEST_FILL, line, 0);
+	memtest_pass(part, MEMTEST_INV_UP, line, 0);
+	memtest_pass(part, MEMTEST_INV_DOWN, line, 0);
+	memtest_pass(part, MEMTEST_CHECK, line, 0);
+
+	part->ticks = get_ticks() - start;
+}
+
+/* Test a part on another CPU */
+static void memtest_cpu_part(void *arg)
+{
+	struct memtest_part *part = arg;
+
+	memtest_part(part);
+	/* Make the results visible before the boot CPU sees 'done' */
+	wmb();
+	WRITE_ONCE(part->done, true);
+}
+
+int memtest_cpu_start(int cpu, struct memtest_part *part)
+{
+	return memtest_cpu_call(cpu, memtest_cpu_part, part);
+}
+
+int memtest_run(struct memtest_part *parts, int count)
+{
+	int cpus = 1;
+	int i;
+
+	parts[0].local = true;
+	for (i = 1; i < count; i++) {
+		parts[i].local = false;
+		parts[i].done = false;
+		if (memtest_cpu_start(i, &parts[i]))
+			parts[i].local = true;
+		else
+			cpus++;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (parts[i].local) {
+			memtest_part(&parts[i]);
+			parts[i].done = true;
+		}
+	}
+
+	for (i = 1; i < count; i++) {
+		if (!parts[i].local)
+			memtest_cpu_wait(i, &parts[i]);
+	}
+
+	return cpus;
+}
@@ -8,6 +8,7 @@
 #include <errno.h>
 #include <fpga.h>
 #include <gzip.h>
+#include <hash.h>
 #include <image.h>
 #include <log.h>
 #include <memalign.h>
@@ -215,6 +216,89 @@ static int get_aligned_image_size(struct spl_load_info *info, int data_size,
 	return (data_size + info->bl_len - 1) / info->bl_len;
 }
 
+/* Find the algorithm of the first hash node of an image */
+static int spl_fit_get_hash_algo(const void *fit, int node,
+				 struct hash_algo **algop)
+{
+	const char *algo;
+	int noffset;
+
+	fdt_for_each_subnode(noffset, fit, node) {
+		if (strncmp(fit_get_name(fit, noffset, NULL), FIT_HASH_NODENAME,
+			    strlen(FIT_HASH_NODENAME)))
+			continue;
+		if (fit_image_hash_get_algo(fit, noffset, &algo))
+			return -ENOENT;
+
+		return hash_lookup_algo(algo, algop);
+	}
+
+	return -ENOENT;
+}
+
+/**
+ * spl_fit_read_data() - read the external data of an image
+ *
+ * With SPL_FIT_STREAM_HASH the data is read in chunks and each chunk is
+ * hashed as soon as it has been read, so that checking the hash node of
+ * the image afterwards does not need to go over the data again.
+ *
+ * @info:	points to information about the device to load data from
+ * @sector:	first sector (or byte offset for FS reads) to read
+ * @count:	number of sectors (or bytes for FS reads) to read
+ * @buf:	buffer to read into
+ * @fit:	pointer to the FIT blob
+ * @node:	offset of the image node
+ * @overhead:	offset of the image data in @buf
+ * @length:	size of the image data
+ *
+ * Return:	number of sectors (or bytes) read, as for info->read()
+ */
+static ulong spl_fit_read_data(struct spl_load_info *info, ulong sector,
+			       ulong count, void *buf, const void *fit,
+			       int node, ulong overhead, size_t length)
+{
+	ALLOC_CACHE_ALIGN_BUFFER(uint8_t, value, FIT_MAX_HASH_LEN);
+	ulong chunk, done, n, end, hashed = overhead;
+	struct hash_algo *algo;
+	void *hash_ctx;
+	int ret = 0;
+
+	if (CONFIG_IS_ENABLED(FIT_STREAM_HASH))
+		fit_image_clear_hash();
+
+	if (!CONFIG_IS_ENABLED(FIT_STREAM_HASH) || info->filename ||
+	    spl_fit_get_hash_algo(fit, node, &algo) || !algo->hash_init ||
+	    algo->hash_init(algo, &hash_ctx))
+		return info->read(info, sector, count, buf);
+
+	chunk = CONFIG_IF_ENABLED_INT(FIT_STREAM_HASH, FIT_STREAM_HASH_CHUNK) /
+		info->bl_len;
+	chunk = max(chunk, 1UL);
+	for (done = 0; done < count; done += n) {
+		n = min(chunk, count - done);
+		if (info->read(info, sector + done, n,
+			       buf + done * info->bl_len) != n)
+			break;
+
+		end = min_t(ulong, (done + n) * info->bl_len, overhead + length);
+		if (!ret && end > hashed) {
+			ret = algo->hash_update(algo, hash_ctx, buf + hashed,
+						end - hashed,
+						end == overhead + length);
+			hashed = end;
+		}
+	}
+
+	if (algo->hash_finish(algo, hash_ctx, value, FIT_MAX_HASH_LEN))
+		ret = -EIO;
+	if (done == count && !ret)
+		fit_image_set_hash(fit, node, buf + overhead, length,
+				   algo->name, value, algo->digest_size);
+
+	return done;
+}
+
 #if defined(CONFIG_DUAL_BOOTLOADER) && defined(CONFIG_IMX_TRUSTY_OS)
 __weak int get_tee_load(ulong *load)
 {
@@ -320,9 +404,10 @@ static int spl_load_fit_image(struct spl_load_info *info, ulong sector,
 		overhead = get_aligned_image_overhead(info, offset);
 		nr_sectors = get_aligned_image_size(info, length, offset);
 
-		if (info->read(info,
-			       sector + get_aligned_image_offset(info, offset),
-			       nr_sectors, src_ptr) != nr_sectors)
+		if (spl_fit_read_data(info,
+				      sector + get_aligned_image_offset(info, offset),
+				      nr_sectors, src_ptr, fit, node, overhead,
+				      length) != nr_sectors)
 			return -EIO;
 
 		debug("External data: dst=%p, offset=%x, size=%lx\n",
@@ -359,7 +444,7 @@ static int spl_load_fit_image(struct spl_load_info *info, ulong sector,
 			return -EIO;
 		}
 		length = size;
-	} else {
+	} else if (load_ptr != src) {
 		memcpy(load_ptr, src, length);
 	}
 
@@ -846,6 +931,13 @@ int spl_load_simple_fit(struct spl_image_info *spl_image,
 			spl_image->fdt_addr = image_info.fdt_addr;
 		}
 
+		/* An OS started through ATF needs to know where it is */
+		if (os_type == IH_OS_ARM_TRUSTED_FIRMWARE) {
+			spl_image->atf_entry = image_info.entry_point;
+			if (spl_image->atf_entry == FDT_ERROR)
+				spl_image->atf_entry = image_info.load_addr;
+		}
+
 		/*
 		 * If the "firmware" image did not provide an entry point,
 		 * use the first valid entry point from the loadables.
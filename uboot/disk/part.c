@@ -216,6 +216,11 @@ void dev_print(struct blk_desc *dev_desc)
 	} else {
 		puts ("            Capacity: not available\n");
 	}
+#if CONFIG_IS_ENABLED(BLK_DMA_BOUNCE)
+	if (blk_dma_bounces(dev_desc))
+		printf("            Bounced: %lu transfers, %llu bytes\n",
+		       dev_desc->bounces, dev_desc->bounce_bytes);
+#endif
 }
 
 void part_init(struct blk_desc *dev_desc)
@@ -11,6 +11,7 @@
 #include <dm.h>
 #include <log.h>
 #include <malloc.h>
+#include <memalign.h>
 #include <part.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
@@ -442,6 +443,117 @@ int blk_get_device(int uclass_id, int devnum, struct udevice **devp)
 	return device_probe(*devp);
 }
 
+#define BLK_BOUNCE_SIZE	CONFIG_IF_ENABLED_INT(BLK_DMA_BOUNCE, BLK_DMA_BOUNCE_SIZE)
+
+/**
+ * struct blk_uclass_priv - State shared by all block devices
+ *
+ * @bounce: Bounce buffer of CONFIG_BLK_DMA_BOUNCE_SIZE bytes, allocated on
+ *	first use and kept for later transfers
+ */
+struct blk_uclass_priv {
+	void *bounce;
+};
+
+/* Check whether the device can transfer to @buf directly */
+static bool blk_dma_ok(struct blk_desc *desc, const void *buf, ulong size)
+{
+	ulong addr = (ulong)buf;
+
+	if (desc->dma_align && ((addr | size) & (desc->dma_align - 1)))
+		return false;
+	if (desc->dma_limit && addr + size - 1 > desc->dma_limit)
+		return false;
+
+	return true;
+}
+
+static void *blk_get_bounce(struct udevice *dev, struct blk_desc *desc)
+{
+	struct blk_uclass_priv *priv = uclass_get_priv(dev->uclass);
+	ulong size = BLK_BOUNCE_SIZE;
+
+	/* A device with stricter limits may need a new bounce buffer */
+	if (priv->bounce && !blk_dma_ok(desc, priv->bounce, size)) {
+		free(priv->bounce);
+		priv->bounce = NULL;
+	}
+	if (!priv->bounce) {
+		priv->bounce = memalign(max_t(ulong, desc->dma_align,
+					      ARCH_DMA_MINALIGN), size);
+		if (priv->bounce && !blk_dma_ok(desc, priv->bounce, size)) {
+			log_debug("No bounce buffer below %llx\n",
+				  (unsigned long long)desc->dma_limit);
+			free(priv->bounce);
+			priv->bounce = NULL;
+		}
+	}
+
+	return priv->bounce;
+}
+
+/*
+ * Read through the bounce buffer, as many blocks at a time as fit, for a
+ * buffer the device cannot reach
+ */
+static long blk_bounce_read(struct udevice *dev, lbaint_t start,
+			    lbaint_t blkcnt, void *buf)
+{
+	struct blk_desc *desc = dev_get_uclass_plat(dev);
+	const struct blk_ops *ops = blk_get_ops(dev);
+	lbaint_t chunk = BLK_BOUNCE_SIZE / desc->blksz;
+	lbaint_t done, count;
+	void *bounce;
+	ulong ret;
+
+	bounce = blk_get_bounce(dev, desc);
+	if (!bounce || !chunk)
+		return -ENOMEM;
+
+	desc->bounces++;
+	for (done = 0; done < blkcnt; done += count) {
+		count = min(blkcnt - done, chunk);
+		ret = ops->read(dev, start + done, count, bounce);
+		if (IS_ERR_VALUE(ret))
+			return done ? done : (long)ret;
+		memcpy(buf + done * desc->blksz, bounce, ret * desc->blksz);
+		desc->bounce_bytes += ret * desc->blksz;
+		if (ret != count)
+			return done + ret;
+	}
+
+	return blkcnt;
+}
+
+static long blk_bounce_write(struct udevice *dev, lbaint_t start,
+			     lbaint_t blkcnt, const void *buf)
+{
+	struct blk_desc *desc = dev_get_uclass_plat(dev);
+	const struct blk_ops *ops = blk_get_ops(dev);
+	lbaint_t chunk = BLK_BOUNCE_SIZE / desc->blksz;
+	lbaint_t done, count;
+	void *bounce;
+	ulong ret;
+
+	bounce = blk_get_bounce(dev, desc);
+	if (!bounce || !chunk)
+		return -ENOMEM;
+
+	desc->bounces++;
+	for (done = 0; done < blkcnt; done += count) {
+		count = min(blkcnt - done, chunk);
+		memcpy(bounce, buf + done * desc->blksz, count * desc->blksz);
+		desc->bounce_bytes += count * desc->blksz;
+		ret = ops->write(dev, start + done, count, bounce);
+		if (IS_ERR_VALUE(ret))
+			return done ? done : (long)ret;
+		if (ret != count)
+			return done + ret;
+	}
+
+	return blkcnt;
+}
+
 long blk_read(struct udevice *dev, lbaint_t start, lbaint_t blkcnt, void *buf)
 {
 	struct blk_desc *desc = dev_get_uclass_plat(dev);
@@ -454,7 +566,11 @@ long blk_read(struct udevice *dev, lbaint_t start, lbaint_t blkcnt, void *buf)
 	if (blkcache_read(desc->uclass_id, desc->devnum,
 			  start, blkcnt, desc->blksz, buf))
 		return blkcnt;
-	blks_read = ops->read(dev, start, blkcnt, buf);
+	if (CONFIG_IS_ENABLED(BLK_DMA_BOUNCE) &&
+	    !blk_dma_ok(desc, buf, blkcnt * desc->blksz))
+		blks_read = blk_bounce_read(dev, start, blkcnt, buf);
+	else
+		blks_read = ops->read(dev, start, blkcnt, buf);
 	if (blks_read == blkcnt)
 		blkcache_fill(desc->uclass_id, desc->devnum, start, blkcnt,
 			      desc->blksz, buf);
@@ -473,6 +589,10 @@ long blk_write(struct udevice *dev, lbaint_t start, lbaint_t blkcnt,
 
 	blkcache_invalidate(desc->uclass_id, desc->devnum);
 
+	if (CONFIG_IS_ENABLED(BLK_DMA_BOUNCE) &&
+	    !blk_dma_ok(desc, buf, blkcnt * desc->blksz))
+		return blk_bounce_write(dev, start, blkcnt, buf);
+
 	return ops->write(dev, start, blkcnt, buf);
 }
 
@@ -779,9 +899,20 @@ static int blk_post_probe(struct udevice *dev)
 	return 0;
 }
 
+static int blk_destroy(struct uclass *uc)
+{
+	struct blk_uclass_priv *priv = uclass_get_priv(uc);
+
+	free(priv->bounce);
+
+	return 0;
+}
+
 UCLASS_DRIVER(blk) = {
 	.id		= UCLASS_BLK,
 	.name		= "blk",
 	.post_probe	= blk_post_probe,
+	.destroy	= blk_destroy,
 	.per_device_plat_auto	= sizeof(struct blk_desc),
+	.priv_auto	= sizeof(struct blk_uclass_priv),
 };
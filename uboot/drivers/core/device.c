@@ -9,6 +9,7 @@
  */
 
 #include <common.h>
+#include <bootstage.h>
 #include <cpu_func.h>
 #include <event.h>
 #include <log.h>
@@ -55,7 +56,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 	if (!name)
 		return -EINVAL;
 
-	ret = uclass_get(drv->id, &uc);
+	ret = uclass_find_or_add(drv->id, &uc);
 	if (ret) {
 		debug("Missing uclass for driver %s\n", drv->name);
 		return ret;
@@ -477,17 +478,11 @@ static int device_get_dma_constraints(struct udevice *dev)
 	return 0;
 }
 
-int device_probe(struct udevice *dev)
+static int device_do_probe(struct udevice *dev)
 {
 	const struct driver *drv;
 	int ret;
 
-	if (!dev)
-		return -EINVAL;
-
-	if (dev_get_flags(dev) & DM_FLAG_ACTIVATED)
-		return 0;
-
 	ret = device_notify(dev, EVT_DM_PRE_PROBE);
 	if (ret)
 		return ret;
@@ -614,6 +609,24 @@ fail:
 	return ret;
 }
 
+int device_probe(struct udevice *dev)
+{
+	int ret, span;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (dev_get_flags(dev) & DM_FLAG_ACTIVATED)
+		return 0;
+
+	/* Probing the parent and any suppliers shows up as nested spans */
+	span = bootstage_span_start(BOOTSTAGE_SPAN_PROBE, dev->name);
+	ret = device_do_probe(dev);
+	bootstage_span_end(span);
+
+	return ret;
+}
+
 void *dev_get_plat(const struct udevice *dev)
 {
 	if (!dev) {
@@ -824,6 +837,7 @@ int device_find_child_by_seq(const struct udevice *parent, int seq,
 {
 	struct udevice *dev;
 
+	dm_lazy_bind_children(parent);
 	*devp = NULL;
 
 	device_foreach_child(dev, parent) {
@@ -853,6 +867,7 @@ int device_find_child_by_of_offset(const struct udevice *parent, int of_offset,
 {
 	struct udevice *dev;
 
+	dm_lazy_bind_children(parent);
 	*devp = NULL;
 
 	device_foreach_child(dev, parent) {
@@ -895,6 +910,7 @@ static struct udevice *_device_find_global_by_ofnode(struct udevice *parent,
 
 int device_find_global_by_ofnode(ofnode ofnode, struct udevice **devp)
 {
+	dm_lazy_bind_node(ofnode);
 	*devp = _device_find_global_by_ofnode(gd->dm_root, ofnode);
 
 	return *devp ? 0 : -ENOENT;
@@ -904,6 +920,7 @@ int device_get_global_by_ofnode(ofnode ofnode, struct udevice **devp)
 {
 	struct udevice *dev;
 
+	dm_lazy_bind_node(ofnode);
 	dev = _device_find_global_by_ofnode(gd->dm_root, ofnode);
 	return device_get_device_tail(dev, dev ? 0 : -ENOENT, devp);
 }
@@ -977,8 +994,14 @@ int device_find_first_child_by_uclass(const struct udevice *parent,
 				      enum uclass_id uclass_id,
 				      struct udevice **devp)
 {
+	struct uclass *uc;
 	struct udevice *dev;
 
+	if (CONFIG_IS_ENABLED(DM_LAZY_BIND)) {
+		uc = uclass_find(uclass_id);
+		if (uc)
+			dm_lazy_bind_uclass(uc);
+	}
 	*devp = NULL;
 	device_foreach_child(dev, parent) {
 		if (device_get_uclass_id(dev) == uclass_id) {
@@ -995,6 +1018,7 @@ int device_find_child_by_namelen(const struct udevice *parent, const char *name,
 {
 	struct udevice *dev;
 
+	dm_lazy_bind_children(parent);
 	*devp = NULL;
 
 	device_foreach_child(dev, parent) {
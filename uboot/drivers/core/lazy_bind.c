@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Binding devicetree nodes the first time they are looked up
+ */
+
+#define LOG_CATEGORY LOGC_DM
+
+#include <common.h>
+#include <dm.h>
+#include <log.h>
+#include <malloc.h>
+#include <asm/global_data.h>
+#include <dm/device-internal.h>
+#include <dm/lists.h>
+#include <dm/uclass-internal.h>
+#include <dm/util.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/**
+ * struct dm_lazy_root - a devicetree subtree waiting to be bound
+ *
+ * @parent: Device to bind @node to
+ * @node: Node at the top of the subtree
+ * @sibling_node: Next subtree in gd->dm_lazy_roots, in the order found
+ * @entry_head: List of nodes in the subtree which have a driver
+ */
+struct dm_lazy_root {
+	struct udevice *parent;
+	ofnode node;
+	struct list_head sibling_node;
+	struct list_head entry_head;
+};
+
+/**
+ * struct dm_lazy_node - a node waiting to be bound
+ *
+ * A deferred subtree has one entry for each node in it which has a driver.
+ * The entry is also on the lazy list of that driver's uclass, so that looking
+ * up the uclass finds the subtrees to bind without a search.
+ *
+ * @root: Subtree holding @node
+ * @node: Node with a driver
+ * @sibling_node: Next entry in @root->entry_head
+ * @uclass_node: Next entry in the lazy list of the uclass
+ */
+struct dm_lazy_node {
+	struct dm_lazy_root *root;
+	ofnode node;
+	struct list_head sibling_node;
+	struct list_head uclass_node;
+};
+
+/*
+ * Find the driver lists_bind_fdt() would try first. If that driver refuses
+ * to bind, another one may end up with the node, but that only means the
+ * node is bound on a lookup of the wrong uclass.
+ */
+static struct driver *lazy_bind_driver(ofnode node)
+{
+	const struct udevice_id *id;
+	const char *compat_list, *compat;
+	struct driver *drv;
+	int len, i;
+
+	compat_list = ofnode_get_property(node, "compatible", &len);
+	if (!compat_list)
+		return NULL;
+
+	for (i = 0; i < len; i += strlen(compat) + 1) {
+		compat = compat_list + i;
+		drv = lists_driver_lookup_compat(compat, &id);
+		if (drv)
+			return drv;
+	}
+
+	return NULL;
+}
+
+static int lazy_bind_add(struct dm_lazy_root *root, ofnode node,
+			 struct driver *drv)
+{
+	struct dm_lazy_node *entry;
+	struct uclass *uc;
+	int ret;
+
+	ret = uclass_find_or_add(drv->id, &uc);
+	if (ret)
+		return log_msg_ret("uc", ret);
+	entry = malloc(sizeof(*entry));
+	if (!entry)
+		return log_msg_ret("lazy", -ENOMEM);
+	entry->root = root;
+	entry->node = node;
+	list_add_tail(&entry->sibling_node, &root->entry_head);
+	list_add_tail(&entry->uclass_node, &uc->lazy_head);
+
+	return 0;
+}
+
+static int lazy_bind_add_tree(struct dm_lazy_root *root, ofnode node)
+{
+	struct driver *drv;
+	ofnode subnode;
+	int ret;
+
+	drv = lazy_bind_driver(node);
+	if (drv) {
+		ret = lazy_bind_add(root, node, drv);
+		if (ret)
+			return ret;
+	}
+
+	ofnode_for_each_subnode(subnode, node) {
+		if (!ofnode_is_enabled(subnode))
+			continue;
+		ret = lazy_bind_add_tree(root, subnode);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* Drop a subtree and all its entries */
+static void lazy_bind_remove(struct dm_lazy_root *root)
+{
+	struct dm_lazy_node *entry, *next;
+
+	list_for_each_entry_safe(entry, next, &root->entry_head, sibling_node) {
+		list_del(&entry->uclass_node);
+		free(entry);
+	}
+	list_del(&root->sibling_node);
+	free(root);
+}
+
+/* Bind a subtree, dropping all its entries */
+static void lazy_bind_root(struct dm_lazy_root *root)
+{
+	struct udevice *parent = root->parent;
+	ofnode node = root->node;
+	int ret;
+
+	/* Drop the entries first, the binding may look up this uclass again */
+	lazy_bind_remove(root);
+
+	log_debug("bind deferred node %s\n", ofnode_get_name(node));
+	ret = lists_bind_fdt(parent, node, NULL, NULL, false);
+	if (ret)
+		dm_warn("Failed to bind deferred node '%s': %d\n",
+			ofnode_get_name(node), ret);
+}
+
+bool dm_lazy_bind_defer(struct udevice *parent, ofnode node)
+{
+	struct dm_lazy_root *root;
+	struct uclass_driver *uc_drv;
+	struct driver *drv;
+
+	if (!ofnode_read_bool(node, "u-boot,lazy-bind")) {
+		drv = lazy_bind_driver(node);
+		if (!drv)
+			return false;
+		uc_drv = lists_uclass_lookup(drv->id);
+		if (!uc_drv || !(uc_drv->flags & DM_UC_FLAG_LAZY_BIND))
+			return false;
+	}
+
+	root = malloc(sizeof(*root));
+	if (!root)
+		return false;
+	root->parent = parent;
+	root->node = node;
+	INIT_LIST_HEAD(&root->entry_head);
+	list_add_tail(&root->sibling_node, &gd->dm_lazy_roots);
+
+	/*
+	 * Record the nodes below as well, since binding this node may bind
+	 * them, e.g. the devices on a bus
+	 */
+	if (lazy_bind_add_tree(root, node) || list_empty(&root->entry_head)) {
+		lazy_bind_remove(root);
+		return false;
+	}
+
+	return true;
+}
+
+void dm_lazy_bind_uclass(struct uclass *uc)
+{
+	struct dm_lazy_node *entry;
+
+	/* Binding changes the list, so start again after each one */
+	while (!list_empty(&uc->lazy_head)) {
+		entry = list_first_entry(&uc->lazy_head, struct dm_lazy_node,
+					 uclass_node);
+		lazy_bind_root(entry->root);
+	}
+}
+
+void dm_lazy_bind_node(ofnode node)
+{
+	struct dm_lazy_root *root;
+	struct dm_lazy_node *entry;
+
+	list_for_each_entry(root, &gd->dm_lazy_roots, sibling_node) {
+		list_for_each_entry(entry, &root->entry_head, sibling_node) {
+			if (ofnode_equal(entry->node, node)) {
+				lazy_bind_root(root);
+				return;
+			}
+		}
+	}
+}
+
+void dm_lazy_bind_children(const struct udevice *parent)
+{
+	struct dm_lazy_root *root, *found;
+
+	/* Binding changes the list, so start again after each one */
+	do {
+		found = NULL;
+		list_for_each_entry(root, &gd->dm_lazy_roots, sibling_node) {
+			if (root->parent == parent) {
+				found = root;
+				break;
+			}
+		}
+		if (found)
+			lazy_bind_root(found);
+	} while (found);
+}
+
+void dm_lazy_bind_drop(struct udevice *parent)
+{
+	struct dm_lazy_root *root, *next;
+
+	list_for_each_entry_safe(root, next, &gd->dm_lazy_roots, sibling_node) {
+		if (root->parent == parent)
+			lazy_bind_remove(root);
+	}
+}
+
+void dm_lazy_bind_drop_uclass(struct uclass *uc)
+{
+	struct dm_lazy_node *entry;
+
+	while (!list_empty(&uc->lazy_head)) {
+		entry = list_first_entry(&uc->lazy_head, struct dm_lazy_node,
+					 uclass_node);
+		lazy_bind_remove(entry->root);
+	}
+}
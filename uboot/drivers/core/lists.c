@@ -18,8 +18,13 @@
 #include <dm/uclass.h>
 #include <dm/util.h>
 #include <fdtdec.h>
+#include <malloc.h>
+#include <sort.h>
+#include <asm/global_data.h>
 #include <linux/compiler.h>
 
+DECLARE_GLOBAL_DATA_PTR;
+
 struct driver *lists_driver_lookup_name(const char *name)
 {
 	struct driver *drv =
@@ -181,11 +186,149 @@ static int driver_check_compatible(const struct udevice_id *of_match,
 	return -ENOENT;
 }
 
-int lists_bind_fdt(struct udevice *parent, ofnode node, struct udevice **devp,
-		   struct driver *drv, bool pre_reloc_only)
+/**
+ * struct dm_compat_entry - one compatible string of one driver
+ *
+ * Indexes are used rather than pointers so that the entry stays valid
+ * whatever address the driver linker list ends up at.
+ *
+ * @drv_idx: Index of the driver in the driver linker list
+ * @id_idx: Index of the string in the of_match table of that driver
+ */
+struct dm_compat_entry {
+	u16 drv_idx;
+	u16 id_idx;
+};
+
+/**
+ * struct dm_compat_index - all compatible strings, sorted
+ *
+ * Entries are sorted by compatible string, then by driver and of_match
+ * order, so that the first entry for a string is the one a linear walk of
+ * the linker list would have found.
+ *
+ * @count: Number of entries
+ * @entry: Entries
+ */
+struct dm_compat_index {
+	int count;
+	struct dm_compat_entry entry[];
+};
+
+static const struct udevice_id *compat_entry_id(const struct dm_compat_entry *e)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+
+	return &driver[e->drv_idx].of_match[e->id_idx];
+}
+
+static int compat_entry_cmp(const void *a, const void *b)
+{
+	const struct dm_compat_entry *ea = a, *eb = b;
+	int ret;
+
+	ret = strcmp(compat_entry_id(ea)->compatible,
+		     compat_entry_id(eb)->compatible);
+	if (ret)
+		return ret;
+	if (ea->drv_idx != eb->drv_idx)
+		return ea->drv_idx - eb->drv_idx;
+
+	return ea->id_idx - eb->id_idx;
+}
+
+static struct dm_compat_index *lists_compat_index(void)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+	const int n_ents = ll_entry_count(struct driver, driver);
+	struct dm_compat_index *idx = gd_dm_compat_index();
+	const struct udevice_id *of_match;
+	int i, j, count = 0;
+
+	if (idx)
+		return idx;
+	if (n_ents > U16_MAX)
+		return NULL;
+
+	for (i = 0; i < n_ents; i++) {
+		for (of_match = driver[i].of_match;
+		     of_match && of_match->compatible; of_match++)
+			count++;
+	}
+
+	idx = malloc(sizeof(*idx) + count * sizeof(idx->entry[0]));
+	if (!idx)
+		return NULL;
+
+	idx->count = 0;
+	for (i = 0; i < n_ents; i++) {
+		of_match = driver[i].of_match;
+		for (j = 0; of_match && of_match[j].compatible; j++) {
+			idx->entry[idx->count].drv_idx = i;
+			idx->entry[idx->count].id_idx = j;
+			idx->count++;
+		}
+	}
+	qsort(idx->entry, idx->count, sizeof(idx->entry[0]), compat_entry_cmp);
+	gd_set_dm_compat_index(idx);
+
+	return idx;
+}
+
+static struct driver *lists_compat_index_lookup(struct dm_compat_index *idx,
+						const char *compat,
+						const struct udevice_id **idp)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+	const struct dm_compat_entry *entry;
+	int lo = 0, hi = idx->count;
+	int mid;
+
+	/* Find the first entry which is not less than @compat */
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (strcmp(compat_entry_id(&idx->entry[mid])->compatible,
+			   compat) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == idx->count)
+		return NULL;
+
+	entry = &idx->entry[lo];
+	*idp = compat_entry_id(entry);
+	if (strcmp((*idp)->compatible, compat))
+		return NULL;
+
+	return &driver[entry->drv_idx];
+}
+
+struct driver *lists_driver_lookup_compat(const char *compat,
+					  const struct udevice_id **idp)
 {
 	struct driver *driver = ll_entry_start(struct driver, driver);
 	const int n_ents = ll_entry_count(struct driver, driver);
+	struct dm_compat_index *idx;
+	struct driver *entry;
+
+	if (CONFIG_IS_ENABLED(DM_COMPAT_INDEX)) {
+		idx = lists_compat_index();
+		if (idx)
+			return lists_compat_index_lookup(idx, compat, idp);
+	}
+
+	for (entry = driver; entry != driver + n_ents; entry++) {
+		if (!driver_check_compatible(entry->of_match, idp, compat))
+			return entry;
+	}
+
+	return NULL;
+}
+
+int lists_bind_fdt(struct udevice *parent, ofnode node, struct udevice **devp,
+		   struct driver *drv, bool pre_reloc_only)
+{
 	const struct udevice_id *id;
 	struct driver *entry;
 	struct udevice *dev;
@@ -223,20 +366,16 @@ int lists_bind_fdt(struct udevice *parent, ofnode node, struct udevice **devp,
 			  compat);
 
 		id = NULL;
-		for (entry = driver; entry != driver + n_ents; entry++) {
-			if (drv) {
-				if (drv != entry)
-					continue;
-				if (!entry->of_match)
-					break;
-			}
-			ret = driver_check_compatible(entry->of_match, &id,
-						      compat);
-			if (!ret)
-				break;
+		if (drv) {
+			if (drv->of_match &&
+			    driver_check_compatible(drv->of_match, &id, compat))
+				continue;
+			entry = drv;
+		} else {
+			entry = lists_driver_lookup_compat(compat, &id);
+			if (!entry)
+				continue;
 		}
-		if (entry == driver + n_ents)
-			continue;
 
 		if (pre_reloc_only) {
 			if (!ofnode_pre_reloc(node) &&
@@ -26,6 +26,7 @@
 #include <linux/bug.h>
 #include <linux/libfdt.h>
 #include <dm/of_access.h>
+#include <dm/of_lookup.h>
 #include <linux/ctype.h>
 #include <linux/err.h>
 #include <linux/ioport.h>
@@ -359,6 +360,12 @@ struct device_node *of_find_node_opts_by_path(struct device_node *root,
 	if (strcmp(path, "/") == 0)
 		return of_node_get(root);
 
+	if (root == gd->of_root && of_live_active()) {
+		np = ofnode_to_np(of_lookup_path(path));
+		if (np)
+			return of_node_get(np);
+	}
+
 	/* The path could begin with an alias */
 	if (*path != '/') {
 		int len;
@@ -453,6 +460,12 @@ struct device_node *of_find_node_by_phandle(struct device_node *root,
 	if (!handle)
 		return NULL;
 
+	if ((!root || root == gd->of_root) && of_live_active()) {
+		np = ofnode_to_np(of_lookup_phandle(handle));
+		if (np)
+			return of_node_get(np);
+	}
+
 	for_each_of_allnodes_from(root, np)
 		if (np->phandle == handle)
 			break;
@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Phandle and path lookup tables for the control devicetree
+ *
+ * Finding a node by phandle or path otherwise means walking the tree, which
+ * driver probe does for every clock, pinctrl, regulator and power-domain
+ * reference. The tables hold no state of their own beyond what the tree
+ * says, so any entry which no longer matches the tree is just ignored.
+ */
+
+#define LOG_CATEGORY LOGC_DT
+
+#include <common.h>
+#include <log.h>
+#include <malloc.h>
+#include <asm/global_data.h>
+#include <dm/of_access.h>
+#include <dm/of_lookup.h>
+#include <linux/libfdt.h>
+#include <linux/log2.h>
+#include <u-boot/crc.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/* Do not build a phandle table with more than this many entries per node */
+#define OF_LOOKUP_MAX_SPARSE	4
+
+/* Link of an entry for a node at the top level of the tree */
+#define OF_LOOKUP_NO_LINK	(~0U)
+
+enum of_lookup_type {
+	OF_LOOKUP_EMPTY,
+	OF_LOOKUP_PATH,
+	OF_LOOKUP_ALIAS,
+};
+
+/**
+ * struct of_lookup_entry - entry in the path hash table
+ *
+ * @hash: CRC32 of the full path or alias name
+ * @type: Type of entry (enum of_lookup_type)
+ * @link: For a path, the entry of the parent node, or OF_LOOKUP_NO_LINK at
+ *	the top level. For an alias, the path entry of the node it refers to
+ * @node: Node the path or alias refers to
+ */
+struct of_lookup_entry {
+	u32 hash;
+	u32 type;
+	u32 link;
+	ofnode node;
+};
+
+/**
+ * struct of_lookup - lookup tables for the control devicetree
+ *
+ * @tree: Flat tree, or root of the live tree, the tables were built for
+ * @struct_size: Size of the structure block of the flat tree, 0 if live
+ * @max_phandle: Highest phandle in the tree
+ * @phandle: Node for each phandle, or NULL if phandles are too sparse
+ * @mask: Number of entries in @path minus 1, a power of two minus 1
+ * @path: Hash table of nodes by path and alias, with linear probing
+ * @aliases: The /aliases node, or ofnode_null() if none
+ */
+struct of_lookup {
+	const void *tree;
+	u32 struct_size;
+	uint max_phandle;
+	ofnode *phandle;
+	uint mask;
+	struct of_lookup_entry *path;
+	ofnode aliases;
+};
+
+/* Only used after relocation */
+static struct of_lookup *of_lookup;
+
+static uint of_lookup_node_phandle(ofnode node)
+{
+	if (ofnode_is_np(node))
+		return ofnode_to_np(node)->phandle;
+
+	return fdt_get_phandle(gd->fdt_blob, ofnode_to_offset(node));
+}
+
+/* The last path component, including any unit address */
+static const char *of_lookup_node_name(ofnode node)
+{
+	if (ofnode_is_np(node))
+		return strrchr(ofnode_to_np(node)->full_name, '/') + 1;
+
+	return fdt_get_name(gd->fdt_blob, ofnode_to_offset(node), NULL);
+}
+
+/*
+ * Check that the node of path entry @i still has the full path @path. In a
+ * flat tree, each component is checked against the name of the node in the
+ * entry for it, going up through the parent entries.
+ */
+static bool of_lookup_check_path(struct of_lookup *lk, uint i,
+				 const char *path)
+{
+	const char *end, *name;
+	ofnode node;
+	int len;
+
+	node = lk->path[i].node;
+	if (ofnode_is_np(node))
+		return !strcmp(ofnode_to_np(node)->full_name, path);
+
+	for (end = path + strlen(path); i != OF_LOOKUP_NO_LINK;
+	     i = lk->path[i].link) {
+		node = lk->path[i].node;
+		name = fdt_get_name(gd->fdt_blob, ofnode_to_offset(node), &len);
+		if (!name || end - path < len + 1 || end[-len - 1] != '/' ||
+		    memcmp(end - len, name, len))
+			return false;
+		end -= len + 1;
+	}
+
+	return end == path;
+}
+
+/* Check that alias entry @i still refers to the same node */
+static bool of_lookup_check_alias(struct of_lookup *lk, uint i,
+				  const char *alias)
+{
+	const char *val;
+
+	val = ofnode_read_string(lk->aliases, alias);
+
+	return val && of_lookup_check_path(lk, lk->path[i].link, val);
+}
+
+static void of_lookup_count(ofnode parent, uint *countp, uint *maxp)
+{
+	ofnode node;
+
+	ofnode_for_each_subnode(node, parent) {
+		(*countp)++;
+		*maxp = max(*maxp, of_lookup_node_phandle(node));
+		of_lookup_count(node, countp, maxp);
+	}
+}
+
+static uint of_lookup_add(struct of_lookup *lk, u32 hash,
+			  enum of_lookup_type type, uint link, ofnode node)
+{
+	uint i;
+
+	for (i = hash & lk->mask; lk->path[i].type; i = (i + 1) & lk->mask)
+		;
+	lk->path[i].hash = hash;
+	lk->path[i].type = type;
+	lk->path[i].link = link;
+	lk->path[i].node = node;
+
+	return i;
+}
+
+/* Find the entry for @key, returning its index or OF_LOOKUP_NO_LINK */
+static uint of_lookup_find(struct of_lookup *lk, const char *key,
+			   enum of_lookup_type type)
+{
+	struct of_lookup_entry *entry;
+	u32 hash = crc32(0, key, strlen(key));
+	bool ok;
+	uint i;
+
+	for (i = hash & lk->mask; lk->path[i].type; i = (i + 1) & lk->mask) {
+		entry = &lk->path[i];
+		if (entry->hash != hash || entry->type != type)
+			continue;
+		if (type == OF_LOOKUP_ALIAS)
+			ok = of_lookup_check_alias(lk, i, key);
+		else
+			ok = of_lookup_check_path(lk, i, key);
+		if (ok)
+			return i;
+	}
+
+	return OF_LOOKUP_NO_LINK;
+}
+
+/*
+ * Add the subnodes of @parent, whose path hashes to @prefix up to its '/' and
+ * whose entry is @link
+ */
+static void of_lookup_fill(struct of_lookup *lk, ofnode parent, u32 prefix,
+			   uint link)
+{
+	const char *name;
+	ofnode node;
+	uint phandle, i;
+	u32 hash;
+
+	ofnode_for_each_subnode(node, parent) {
+		name = of_lookup_node_name(node);
+		hash = crc32(prefix, name, strlen(name));
+		i = of_lookup_add(lk, hash, OF_LOOKUP_PATH, link, node);
+
+		phandle = of_lookup_node_phandle(node);
+		if (phandle && lk->phandle)
+			lk->phandle[phandle] = node;
+
+		of_lookup_fill(lk, node, crc32(hash, "/", 1), i);
+	}
+}
+
+static void of_lookup_fill_aliases(struct of_lookup *lk)
+{
+	struct ofprop prop;
+	const char *name, *val;
+	int len;
+	uint i;
+
+	ofnode_for_each_prop(prop, lk->aliases) {
+		val = ofprop_get_property(&prop, &name, &len);
+		if (!val || len < 2 || *val != '/' || val[len - 1])
+			continue;
+		i = of_lookup_find(lk, val, OF_LOOKUP_PATH);
+		if (i != OF_LOOKUP_NO_LINK)
+			of_lookup_add(lk, crc32(0, name, strlen(name)),
+				      OF_LOOKUP_ALIAS, i, lk->path[i].node);
+	}
+}
+
+static void of_lookup_free(struct of_lookup *lk)
+{
+	if (lk) {
+		free(lk->phandle);
+		free(lk->path);
+		free(lk);
+	}
+}
+
+static struct of_lookup *of_lookup_build(const void *tree, u32 struct_size)
+{
+	uint count = 0, max_phandle = 0, entries, i;
+	ofnode root, aliases;
+	struct ofprop prop;
+	struct of_lookup *lk;
+
+	root = ofnode_root();
+	of_lookup_count(root, &count, &max_phandle);
+	entries = count;
+	aliases = ofnode_find_subnode(root, "aliases");
+	if (ofnode_valid(aliases)) {
+		ofnode_for_each_prop(prop, aliases)
+			entries++;
+	}
+
+	lk = calloc(1, sizeof(*lk));
+	if (!lk)
+		return NULL;
+	lk->tree = tree;
+	lk->struct_size = struct_size;
+	lk->max_phandle = max_phandle;
+	lk->aliases = aliases;
+	lk->mask = roundup_pow_of_two(entries * 2 + 1) - 1;
+	lk->path = calloc(lk->mask + 1, sizeof(*lk->path));
+	if (!lk->path)
+		goto err;
+	if (max_phandle && max_phandle <= count * OF_LOOKUP_MAX_SPARSE) {
+		lk->phandle = malloc((max_phandle + 1) * sizeof(ofnode));
+		if (!lk->phandle)
+			goto err;
+		for (i = 0; i <= max_phandle; i++)
+			lk->phandle[i] = ofnode_null();
+	}
+
+	of_lookup_fill(lk, root, crc32(0, "/", 1), OF_LOOKUP_NO_LINK);
+	if (ofnode_valid(aliases))
+		of_lookup_fill_aliases(lk);
+	log_debug("%u nodes, %u path entries, max phandle %u\n", count,
+		  lk->mask + 1, max_phandle);
+
+	return lk;
+err:
+	of_lookup_free(lk);
+
+	return NULL;
+}
+
+/* Get the tables for the control devicetree, building them if needed */
+static struct of_lookup *of_lookup_get(void)
+{
+	u32 struct_size = 0;
+	const void *tree;
+
+	/* Before relocation there is no BSS and little malloc() space */
+	if (!(gd->flags & GD_FLG_RELOC))
+		return NULL;
+
+	if (of_live_active()) {
+		tree = gd_of_root();
+	} else {
+		tree = gd->fdt_blob;
+		if (tree)
+			struct_size = fdt_size_dt_struct(tree);
+	}
+	if (!tree)
+		return NULL;
+
+	/*
+	 * Adding or removing anything in a flat tree moves the nodes after
+	 * it and changes the size of the structure block
+	 */
+	if (of_lookup && of_lookup->tree == tree &&
+	    of_lookup->struct_size == struct_size)
+		return of_lookup;
+
+	of_lookup_free(of_lookup);
+	of_lookup = of_lookup_build(tree, struct_size);
+
+	return of_lookup;
+}
+
+ofnode of_lookup_phandle(uint phandle)
+{
+	struct of_lookup *lk;
+	ofnode node;
+
+	lk = of_lookup_get();
+	if (!lk || !lk->phandle || !phandle || phandle > lk->max_phandle)
+		return ofnode_null();
+
+	node = lk->phandle[phandle];
+	if (!ofnode_valid(node) || of_lookup_node_phandle(node) != phandle)
+		return ofnode_null();
+
+	return node;
+}
+
+ofnode of_lookup_path(const char *path)
+{
+	bool alias = *path != '/';
+	struct of_lookup *lk;
+	uint i;
+
+	/* Leave options, paths below an alias and the root to the caller */
+	if (strchr(path, ':') || (alias ? !!strchr(path, '/') : !path[1]))
+		return ofnode_null();
+
+	lk = of_lookup_get();
+	if (!lk)
+		return ofnode_null();
+
+	i = of_lookup_find(lk, path, alias ? OF_LOOKUP_ALIAS : OF_LOOKUP_PATH);
+	if (i == OF_LOOKUP_NO_LINK)
+		return ofnode_null();
+
+	return lk->path[i].node;
+}
@@ -15,6 +15,7 @@
 #include <linux/libfdt.h>
 #include <dm/of_access.h>
 #include <dm/of_addr.h>
+#include <dm/of_lookup.h>
 #include <dm/ofnode.h>
 #include <linux/err.h>
 #include <linux/ioport.h>
@@ -584,8 +585,10 @@ ofnode ofnode_get_by_phandle(uint phandle)
 	ofnode node;
 
 	if (of_live_active())
-		node = np_to_ofnode(of_find_node_by_phandle(NULL, phandle));
-	else
+		return np_to_ofnode(of_find_node_by_phandle(NULL, phandle));
+
+	node = of_lookup_phandle(phandle);
+	if (!ofnode_valid(node))
 		node.of_offset = fdt_node_offset_by_phandle(gd->fdt_blob,
 							    phandle);
 
@@ -816,10 +819,16 @@ int ofnode_count_phandle_with_args(ofnode node, const char *list_name,
 
 ofnode ofnode_path(const char *path)
 {
+	ofnode node;
+
 	if (of_live_active())
 		return np_to_ofnode(of_find_node_by_path(path));
-	else
-		return offset_to_ofnode(fdt_path_offset(gd->fdt_blob, path));
+
+	node = of_lookup_path(path);
+	if (!ofnode_valid(node))
+		node = offset_to_ofnode(fdt_path_offset(gd->fdt_blob, path));
+
+	return node;
 }
 
 ofnode oftree_root(oftree tree)
@@ -9,6 +9,7 @@
 #define LOG_CATEGORY UCLASS_ROOT
 
 #include <common.h>
+#include <bootstage.h>
 #include <errno.h>
 #include <fdtdec.h>
 #include <log.h>
@@ -206,6 +207,9 @@ int dm_init(bool of_live)
 	}
 
 	INIT_LIST_HEAD((struct list_head *)&gd->dmtag_list);
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+	INIT_LIST_HEAD(&gd->dm_lazy_roots);
+#endif
 
 	return 0;
 }
@@ -285,6 +289,10 @@ static int dm_scan_fdt_node(struct udevice *parent, ofnode parent_node,
 			pr_debug("   - ignoring disabled device\n");
 			continue;
 		}
+		if (!pre_reloc_only && dm_lazy_bind_defer(parent, node)) {
+			pr_debug("   - binding on first use\n");
+			continue;
+		}
 		err = lists_bind_fdt(parent, node, NULL, NULL, pre_reloc_only);
 		if (err && !ret) {
 			ret = err;
@@ -406,7 +414,9 @@ static int dm_scan(bool pre_reloc_only)
 	}
 
 	if (CONFIG_IS_ENABLED(OF_REAL)) {
+		bootstage_start(BOOTSTAGE_ID_ACCUM_DM_BIND, "dm_bind");
 		ret = dm_extended_scan(pre_reloc_only);
+		bootstage_accum(BOOTSTAGE_ID_ACCUM_DM_BIND);
 		if (ret) {
 			debug("dm_extended_scan() failed: %d\n", ret);
 			return ret;
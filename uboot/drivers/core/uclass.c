@@ -9,6 +9,7 @@
 #define LOG_CATEGORY LOGC_DM
 
 #include <common.h>
+#include <bootstage.h>
 #include <dm.h>
 #include <errno.h>
 #include <log.h>
@@ -85,6 +86,9 @@ static int uclass_add(enum uclass_id id, struct uclass **ucp)
 	uc->uc_drv = uc_drv;
 	INIT_LIST_HEAD(&uc->sibling_node);
 	INIT_LIST_HEAD(&uc->dev_head);
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+	INIT_LIST_HEAD(&uc->lazy_head);
+#endif
 	list_add(&uc->sibling_node, DM_UCLASS_ROOT_NON_CONST);
 
 	if (uc_drv->init) {
@@ -130,6 +134,7 @@ int uclass_destroy(struct uclass *uc)
 		if (ret)
 			return log_msg_ret("unbind", ret);
 	}
+	dm_lazy_bind_drop_uclass(uc);
 
 	uc_drv = uc->uc_drv;
 	if (uc_drv->destroy)
@@ -142,7 +147,7 @@ int uclass_destroy(struct uclass *uc)
 	return 0;
 }
 
-int uclass_get(enum uclass_id id, struct uclass **ucp)
+int uclass_find_or_add(enum uclass_id id, struct uclass **ucp)
 {
 	struct uclass *uc;
 
@@ -161,6 +166,18 @@ int uclass_get(enum uclass_id id, struct uclass **ucp)
 	return 0;
 }
 
+int uclass_get(enum uclass_id id, struct uclass **ucp)
+{
+	int ret;
+
+	ret = uclass_find_or_add(id, ucp);
+	if (ret)
+		return ret;
+	dm_lazy_bind_uclass(*ucp);
+
+	return 0;
+}
+
 const char *uclass_get_name(enum uclass_id id)
 {
 	struct uclass *uc;
@@ -764,7 +781,7 @@ int uclass_pre_probe_device(struct udevice *dev)
 int uclass_post_probe_device(struct udevice *dev)
 {
 	struct uclass_driver *uc_drv;
-	int ret;
+	int ret, span;
 
 	if (dev->parent) {
 		uc_drv = dev->parent->uclass->uc_drv;
@@ -777,7 +794,10 @@ int uclass_post_probe_device(struct udevice *dev)
 
 	uc_drv = dev->uclass->uc_drv;
 	if (uc_drv->post_probe) {
+		span = bootstage_span_start(BOOTSTAGE_SPAN_POST_PROBE,
+					    uc_drv->name);
 		ret = uc_drv->post_probe(dev);
+		bootstage_span_end(span);
 		if (ret)
 			return ret;
 	}
@@ -325,6 +325,18 @@ static int aspeed_hace_digest(struct udevice *dev, enum HASH_ALGO algo,
 	return aspeed_hace_digest_wd(dev, algo, ibuf, ilen, obuf, ilen);
 }
 
+static int aspeed_hace_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *uc_plat = dev_get_uclass_plat(dev);
+
+	uc_plat->prio[HASH_ALGO_SHA1] = HASH_PRIO_HW;
+	uc_plat->prio[HASH_ALGO_SHA256] = HASH_PRIO_HW;
+	uc_plat->prio[HASH_ALGO_SHA384] = HASH_PRIO_HW;
+	uc_plat->prio[HASH_ALGO_SHA512] = HASH_PRIO_HW;
+
+	return 0;
+}
+
 static int aspeed_hace_probe(struct udevice *dev)
 {
 	int rc;
@@ -374,6 +386,7 @@ U_BOOT_DRIVER(aspeed_hace) = {
 	.id = UCLASS_HASH,
 	.of_match = aspeed_hace_ids,
 	.ops = &aspeed_hace_ops,
+	.bind = aspeed_hace_bind,
 	.probe = aspeed_hace_probe,
 	.remove	= aspeed_hace_remove,
 	.priv_auto = sizeof(struct aspeed_hace),
@@ -15,7 +15,9 @@
 #include "fsl_hash.h"
 #include <hw_sha.h>
 #include <asm/cache.h>
+#include <dm.h>
 #include <linux/errno.h>
+#include <u-boot/hash.h>
 
 #define CRYPTO_MAX_ALG_NAME	80
 #define SHA1_DIGEST_SIZE        20
@@ -173,7 +175,7 @@ static int caam_hash_finish(void *hash_ctx, void *dest_buf,
 	} else {
 		invalidate_dcache_range((ulong)ctx->hash,
 					(ulong)(ctx->hash) + driver_hash[caam_algo].digestsize);
-		memcpy(dest_buf, ctx->hash, sizeof(ctx->hash));
+		memcpy(dest_buf, ctx->hash, driver_hash[caam_algo].digestsize);
 	}
 	free(ctx);
 	return ret;
@@ -245,3 +247,191 @@ int hw_sha_finish(struct hash_algo *algo, void *ctx, void *dest_buf,
 {
 	return caam_hash_finish(ctx, dest_buf, size, get_hash_type(algo));
 }
+
+#if CONFIG_IS_ENABLED(FSL_CAAM_DM_HASH)
+/*
+ * All-in-one hash job handed over to the job ring
+ *
+ * @desc: Job descriptor, first so that it starts on a cache line
+ * @hash: Digest written by CAAM, in cache lines of its own
+ * @op: Job ring completion status
+ * @obuf: Caller buffer receiving the digest on completion
+ * @algo: Enum for SHA1 or SHA256
+ */
+struct caam_hash_req {
+	uint32_t desc[MAX_CAAM_DESCSIZE];
+	u8 hash[ALIGN(SHA256_DIGEST_SIZE, ARCH_DMA_MINALIGN)]
+		__aligned(ARCH_DMA_MINALIGN);
+	struct result op __aligned(ARCH_DMA_MINALIGN);
+	void *obuf;
+	enum caam_hash_algos algo;
+};
+
+static int caam_hash_get_algo(enum HASH_ALGO algo)
+{
+	switch (algo) {
+	case HASH_ALGO_SHA1:
+		return SHA1;
+	case HASH_ALGO_SHA256:
+		return SHA256;
+	default:
+		return -EPROTONOSUPPORT;
+	}
+}
+
+static int caam_hash_dm_init(struct udevice *dev, enum HASH_ALGO algo,
+			     void **ctxp)
+{
+	struct sha_ctx *ctx;
+	int caam_algo, ret;
+
+	caam_algo = caam_hash_get_algo(algo);
+	if (caam_algo < 0)
+		return caam_algo;
+
+	ret = caam_hash_init(ctxp, caam_algo);
+	if (ret)
+		return ret;
+	ctx = *ctxp;
+	ctx->algo = caam_algo;
+
+	return 0;
+}
+
+static int caam_hash_dm_update(struct udevice *dev, void *hash_ctx,
+			       const void *ibuf, const uint32_t ilen)
+{
+	struct sha_ctx *ctx = hash_ctx;
+
+	return caam_hash_update(ctx, ibuf, ilen, 0, ctx->algo);
+}
+
+static int caam_hash_dm_finish(struct udevice *dev, void *hash_ctx,
+			       void *obuf)
+{
+	struct sha_ctx *ctx = hash_ctx;
+	uint32_t final;
+
+	if (!ctx->sg_num) {
+		free(ctx);
+		return -EINVAL;
+	}
+
+	/* The last update is only known now, so mark the table end here */
+	final = sec_in32(&ctx->sg_tbl[ctx->sg_num - 1].len_flag) |
+		SG_ENTRY_FINAL_BIT;
+	sec_out32(&ctx->sg_tbl[ctx->sg_num - 1].len_flag, final);
+
+	return caam_hash_finish(ctx, obuf, driver_hash[ctx->algo].digestsize,
+				ctx->algo);
+}
+
+static int caam_hash_dm_digest_start(struct udevice *dev, enum HASH_ALGO algo,
+				     const void *ibuf, const uint32_t ilen,
+				     void *obuf, void **reqp)
+{
+	struct caam_hash_req *req;
+	int caam_algo, ret;
+
+	caam_algo = caam_hash_get_algo(algo);
+	if (caam_algo < 0)
+		return caam_algo;
+
+	req = malloc_cache_aligned(sizeof(*req));
+	if (!req)
+		return -ENOMEM;
+	req->obuf = obuf;
+	req->algo = caam_algo;
+
+	flush_dcache_range((ulong)ibuf,
+			   (ulong)ibuf + ALIGN(ilen, ARCH_DMA_MINALIGN));
+	inline_cnstr_jobdesc_hash(req->desc, ibuf, ilen, req->hash,
+				  driver_hash[caam_algo].alg_type,
+				  driver_hash[caam_algo].digestsize, 0);
+	flush_dcache_range((ulong)req->desc,
+			   (ulong)req->desc + sizeof(req->desc));
+	invalidate_dcache_range((ulong)req->hash,
+				(ulong)req->hash + sizeof(req->hash));
+
+	ret = start_descriptor_jr(req->desc, &req->op);
+	if (ret) {
+		debug("Error %x\n", ret);
+		free(req);
+		return -EIO;
+	}
+	*reqp = req;
+
+	return 0;
+}
+
+static int caam_hash_dm_digest_wait(struct udevice *dev, void *reqp)
+{
+	struct caam_hash_req *req = reqp;
+	int ret;
+
+	ret = wait_descriptor_jr(&req->op);
+	if (!ret) {
+		invalidate_dcache_range((ulong)req->hash,
+					(ulong)req->hash + sizeof(req->hash));
+		memcpy(req->obuf, req->hash,
+		       driver_hash[req->algo].digestsize);
+	} else {
+		debug("Error %x\n", ret);
+	}
+	free(req);
+
+	return ret ? -EIO : 0;
+}
+
+static int caam_hash_dm_digest(struct udevice *dev, enum HASH_ALGO algo,
+			       const void *ibuf, const uint32_t ilen,
+			       void *obuf)
+{
+	void *req;
+	int ret;
+
+	ret = caam_hash_dm_digest_start(dev, algo, ibuf, ilen, obuf, &req);
+	if (ret)
+		return ret;
+
+	return caam_hash_dm_digest_wait(dev, req);
+}
+
+static int caam_hash_dm_digest_wd(struct udevice *dev, enum HASH_ALGO algo,
+				  const void *ibuf, const uint32_t ilen,
+				  void *obuf, uint32_t chunk_sz)
+{
+	/*
+	 * CAAM hashes the whole buffer in one job. The watchdog is still
+	 * served while waiting for it, as udelay() calls schedule().
+	 */
+	return caam_hash_dm_digest(dev, algo, ibuf, ilen, obuf);
+}
+
+static int caam_hash_dm_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *uc_plat = dev_get_uclass_plat(dev);
+
+	uc_plat->prio[HASH_ALGO_SHA1] = HASH_PRIO_HW;
+	uc_plat->prio[HASH_ALGO_SHA256] = HASH_PRIO_HW;
+
+	return 0;
+}
+
+static const struct hash_ops caam_hash_ops = {
+	.hash_init = caam_hash_dm_init,
+	.hash_update = caam_hash_dm_update,
+	.hash_finish = caam_hash_dm_finish,
+	.hash_digest = caam_hash_dm_digest,
+	.hash_digest_wd = caam_hash_dm_digest_wd,
+	.hash_digest_start = caam_hash_dm_digest_start,
+	.hash_digest_wait = caam_hash_dm_digest_wait,
+};
+
+U_BOOT_DRIVER(caam_hash) = {
+	.name	= "caam_hash",
+	.id	= UCLASS_HASH,
+	.ops	= &caam_hash_ops,
+	.bind	= caam_hash_dm_bind,
+};
+#endif
@@ -21,6 +21,7 @@
  * @len: total length of buffer
  * @sg_tbl: sg entry table
  * @hash: index to the hash calculated
+ * @algo: algorithm selected by the hash uclass driver
  */
 struct sha_ctx {
 	uint32_t sha_desc[64];
@@ -28,6 +29,7 @@ struct sha_ctx {
 	uint32_t len;
 	struct sg_entry sg_tbl[MAX_SG_32];
 	u8 hash[HASH_MAX_DIGEST_SIZE];
+	uint32_t algo;
 };
 
 #endif
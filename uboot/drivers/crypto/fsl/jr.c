@@ -327,52 +327,86 @@ static void desc_done(uint32_t status, void *arg)
 	x->done = 1;
 }
 
-static inline int run_descriptor_jr_idx(uint32_t *desc, uint8_t sec_idx)
+static struct caam_regs *jr_get_caam(void)
 {
-	struct caam_regs *caam;
 #if CONFIG_IS_ENABLED(DM)
-	caam = dev_get_priv(caam_dev);
+	return dev_get_priv(caam_dev);
 #else
-	caam = &caam_st;
+	return &caam_st;
 #endif
+}
+
+static int start_descriptor_jr_idx(uint32_t *desc, struct result *op,
+				   uint8_t sec_idx)
+{
+	struct caam_regs *caam = jr_get_caam();
+	struct jobring *jr = &caam->jr[sec_idx];
 	unsigned long long timeval = 0;
-	unsigned long long timeout = CFG_USEC_DEQ_TIMEOUT;
-	struct result op;
-	int ret = 0;
 
-	memset(&op, 0, sizeof(op));
+	memset(op, 0, sizeof(*op));
 
-	ret = jr_enqueue(desc, desc_done, &op, sec_idx, caam);
-	if (ret) {
+	/* Reap completed jobs until there is room in the input ring */
+	while (!CIRC_SPACE(jr->head, jr->tail, jr->size)) {
+		if (jr_dequeue(sec_idx, caam)) {
+			debug("Error in SEC deq\n");
+			return JQ_DEQ_ERR;
+		}
+		if (++timeval > CFG_USEC_DEQ_TIMEOUT) {
+			debug("SEC Dequeue timed out\n");
+			return JQ_DEQ_TO_ERR;
+		}
+		udelay(1);
+	}
+
+	if (jr_enqueue(desc, desc_done, op, sec_idx, caam)) {
 		debug("Error in SEC enq\n");
-		ret = JQ_ENQ_ERR;
-		goto out;
+		return JQ_ENQ_ERR;
 	}
 
-	while (op.done != 1) {
+	return 0;
+}
+
+static int wait_descriptor_jr_idx(struct result *op, uint8_t sec_idx)
+{
+	struct caam_regs *caam = jr_get_caam();
+	unsigned long long timeval = 0;
+	unsigned long long timeout = CFG_USEC_DEQ_TIMEOUT;
+	int ret;
+
+	while (op->done != 1) {
 		udelay(1);
 		timeval += 1;
 
 		ret = jr_dequeue(sec_idx, caam);
 		if (ret) {
 			debug("Error in SEC deq\n");
-			ret = JQ_DEQ_ERR;
-			goto out;
+			return JQ_DEQ_ERR;
 		}
 
 		if (timeval > timeout) {
 			debug("SEC Dequeue timed out\n");
-			ret = JQ_DEQ_TO_ERR;
-			goto out;
+			return JQ_DEQ_TO_ERR;
 		}
 	}
 
-	if (op.status) {
-		debug("Error %x\n", op.status);
-		ret = op.status;
+	if (op->status) {
+		debug("Error %x\n", op->status);
+		return op->status;
 	}
-out:
-	return ret;
+
+	return 0;
+}
+
+static inline int run_descriptor_jr_idx(uint32_t *desc, uint8_t sec_idx)
+{
+	struct result op;
+	int ret;
+
+	ret = start_descriptor_jr_idx(desc, &op, sec_idx);
+	if (ret)
+		return ret;
+
+	return wait_descriptor_jr_idx(&op, sec_idx);
 }
 
 int run_descriptor_jr(uint32_t *desc)
@@ -380,6 +414,16 @@ int run_descriptor_jr(uint32_t *desc)
 	return run_descriptor_jr_idx(desc, 0);
 }
 
+int start_descriptor_jr(uint32_t *desc, struct result *op)
+{
+	return start_descriptor_jr_idx(desc, op, 0);
+}
+
+int wait_descriptor_jr(struct result *op)
+{
+	return wait_descriptor_jr_idx(op, 0);
+}
+
 static int jr_sw_cleanup(uint8_t sec_idx, struct caam_regs *caam)
 {
 	struct jobring *jr = &caam->jr[sec_idx];
@@ -1009,6 +1053,9 @@ static int caam_jr_probe(struct udevice *dev)
 
 static int caam_jr_bind(struct udevice *dev)
 {
+	if (CONFIG_IS_ENABLED(FSL_CAAM_DM_HASH))
+		return device_bind_driver(dev, "caam_hash", "caam_hash", NULL);
+
 	return 0;
 }
 
@@ -134,6 +134,19 @@ struct caam_regs {
 void caam_jr_strstatus(u32 status);
 int run_descriptor_jr(uint32_t *desc);
 
+/*
+ * Asynchronous job submission
+ *
+ * start_descriptor_jr() queues @desc on the job ring and returns as soon as
+ * the hardware owns it, waiting only if the ring is full. Several jobs may be
+ * outstanding at once. @op must stay valid until wait_descriptor_jr() has
+ * returned for it; @op->done is set when the job completes, which happens
+ * during any later call to start_descriptor_jr() or wait_descriptor_jr().
+ * These return 0 or a JQ_* / CAAM status error.
+ */
+int start_descriptor_jr(uint32_t *desc, struct result *op);
+int wait_descriptor_jr(struct result *op);
+
 #ifdef CONFIG_RNG_SELF_TEST
 void rng_self_test(void);
 #endif
@@ -8,11 +8,13 @@
 
 #include <common.h>
 #include <dm.h>
+#include <log.h>
 #include <asm/global_data.h>
 #include <u-boot/hash.h>
 #include <errno.h>
 #include <fdtdec.h>
 #include <malloc.h>
+#include <dm/device-internal.h>
 #include <asm/io.h>
 #include <linux/list.h>
 
@@ -115,7 +117,70 @@ int hash_finish(struct udevice *dev, void *ctx, void *obuf)
 	return ops->hash_finish(dev, ctx, obuf);
 }
 
+int hash_digest_start(struct udevice *dev, enum HASH_ALGO algo,
+		      const void *ibuf, const uint32_t ilen, void *obuf,
+		      void **reqp)
+{
+	struct hash_ops *ops = (struct hash_ops *)device_get_ops(dev);
+
+	if (!ops->hash_digest_start) {
+		/* no queue in this device, so complete the request now */
+		*reqp = NULL;
+		return hash_digest(dev, algo, ibuf, ilen, obuf);
+	}
+
+	return ops->hash_digest_start(dev, algo, ibuf, ilen, obuf, reqp);
+}
+
+int hash_digest_wait(struct udevice *dev, void *req)
+{
+	struct hash_ops *ops = (struct hash_ops *)device_get_ops(dev);
+
+	if (!req)
+		return 0;
+	if (!ops->hash_digest_wait)
+		return -ENOSYS;
+
+	return ops->hash_digest_wait(dev, req);
+}
+
+int hash_get_device(enum HASH_ALGO algo, struct udevice **devp)
+{
+	struct hash_uc_plat *uc_plat;
+	struct udevice *dev;
+	struct uclass *uc;
+	int prio, ret;
+
+	if (algo >= HASH_ALGO_NUM)
+		return -EINVAL;
+
+	ret = uclass_get(UCLASS_HASH, &uc);
+	if (ret)
+		return ret;
+
+	for (prio = HASH_PRIO_HW; prio <= HASH_PRIO_SW; prio++) {
+		uclass_foreach_dev(dev, uc) {
+			uc_plat = dev_get_uclass_plat(dev);
+			if (uc_plat->prio[algo] != prio)
+				continue;
+
+			ret = device_probe(dev);
+			if (ret) {
+				log_debug("Cannot probe %s (err=%d)\n",
+					  dev->name, ret);
+				continue;
+			}
+			*devp = dev;
+
+			return 0;
+		}
+	}
+
+	return -ENODEV;
+}
+
 UCLASS_DRIVER(hash) = {
 	.id	= UCLASS_HASH,
 	.name	= "hash",
+	.per_device_plat_auto	= sizeof(struct hash_uc_plat),
 };
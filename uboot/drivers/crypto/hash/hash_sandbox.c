@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Sandbox stand-in for a hash engine with a job queue, such as CAAM
+ *
+ * Requests started with hash_digest_start() are only computed when they are
+ * waited for, so that tests can check that callers do not use the digest
+ * too early.
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <image.h>
+#include <malloc.h>
+#include <u-boot/hash.h>
+#include <u-boot/sha1.h>
+#include <u-boot/sha256.h>
+
+/**
+ * struct sandbox_hash_req - a queued hash request
+ *
+ * @algo: Algorithm to use
+ * @ibuf: Input buffer
+ * @ilen: Length of @ibuf in bytes
+ * @obuf: Output buffer for the digest
+ */
+struct sandbox_hash_req {
+	enum HASH_ALGO algo;
+	const void *ibuf;
+	uint32_t ilen;
+	void *obuf;
+};
+
+static int sandbox_hash_digest(struct udevice *dev, enum HASH_ALGO algo,
+			       const void *ibuf, const uint32_t ilen,
+			       void *obuf)
+{
+	switch (algo) {
+	case HASH_ALGO_SHA1:
+		sha1_csum_wd(ibuf, ilen, obuf, CHUNKSZ_SHA1);
+		break;
+	case HASH_ALGO_SHA256:
+		sha256_csum_wd(ibuf, ilen, obuf, CHUNKSZ_SHA256);
+		break;
+	default:
+		return -EPROTONOSUPPORT;
+	}
+
+	return 0;
+}
+
+static int sandbox_hash_digest_wd(struct udevice *dev, enum HASH_ALGO algo,
+				  const void *ibuf, const uint32_t ilen,
+				  void *obuf, uint32_t chunk_sz)
+{
+	return sandbox_hash_digest(dev, algo, ibuf, ilen, obuf);
+}
+
+static int sandbox_hash_digest_start(struct udevice *dev, enum HASH_ALGO algo,
+				     const void *ibuf, const uint32_t ilen,
+				     void *obuf, void **reqp)
+{
+	struct sandbox_hash_req *req;
+
+	if (algo != HASH_ALGO_SHA1 && algo != HASH_ALGO_SHA256)
+		return -EPROTONOSUPPORT;
+
+	req = malloc(sizeof(*req));
+	if (!req)
+		return -ENOMEM;
+	req->algo = algo;
+	req->ibuf = ibuf;
+	req->ilen = ilen;
+	req->obuf = obuf;
+	*reqp = req;
+
+	return 0;
+}
+
+static int sandbox_hash_digest_wait(struct udevice *dev, void *reqp)
+{
+	struct sandbox_hash_req *req = reqp;
+	int ret;
+
+	ret = sandbox_hash_digest(dev, req->algo, req->ibuf, req->ilen,
+				  req->obuf);
+	free(req);
+
+	return ret;
+}
+
+static int sandbox_hash_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *uc_plat = dev_get_uclass_plat(dev);
+
+	uc_plat->prio[HASH_ALGO_SHA1] = HASH_PRIO_HW;
+	uc_plat->prio[HASH_ALGO_SHA256] = HASH_PRIO_HW;
+
+	return 0;
+}
+
+static const struct hash_ops sandbox_hash_ops = {
+	.hash_digest = sandbox_hash_digest,
+	.hash_digest_wd = sandbox_hash_digest_wd,
+	.hash_digest_start = sandbox_hash_digest_start,
+	.hash_digest_wait = sandbox_hash_digest_wait,
+};
+
+static const struct udevice_id sandbox_hash_ids[] = {
+	{ .compatible = "sandbox,hash" },
+	{ }
+};
+
+U_BOOT_DRIVER(sandbox_hash) = {
+	.name = "sandbox_hash",
+	.id = UCLASS_HASH,
+	.of_match = sandbox_hash_ids,
+	.ops = &sandbox_hash_ops,
+	.bind = sandbox_hash_bind,
+};
@@ -9,6 +9,7 @@
 #include <log.h>
 #include <malloc.h>
 #include <watchdog.h>
+#include <asm/unaligned.h>
 #include <u-boot/hash.h>
 #include <u-boot/crc.h>
 #include <u-boot/md5.h>
@@ -45,7 +46,8 @@ static void hash_update_crc32(void *ctx, const void *ibuf, uint32_t ilen)
 
 static void hash_finish_crc32(void *ctx, void *obuf)
 {
-	*((uint32_t *)obuf) = *((uint32_t *)ctx);
+	/* big-endian, as stored in FIT hash nodes by crc32_wd_buf() */
+	put_unaligned_be32(*((uint32_t *)ctx), obuf);
 }
 
 /* MD5 */
@@ -281,6 +283,23 @@ static int sw_hash_digest(struct udevice *dev, enum HASH_ALGO algo,
 	return sw_hash_digest_wd(dev, algo, ibuf, ilen, obuf, ilen);
 }
 
+static int sw_hash_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *uc_plat = dev_get_uclass_plat(dev);
+	int i;
+
+	for (i = 0; i < HASH_ALGO_NUM; i++)
+		uc_plat->prio[i] = HASH_PRIO_SW;
+
+	/* lib/sha*.c use the Crypto Extensions when they are enabled */
+	if (IS_ENABLED(CONFIG_ARMV8_CE_SHA1))
+		uc_plat->prio[HASH_ALGO_SHA1] = HASH_PRIO_CPU;
+	if (IS_ENABLED(CONFIG_ARMV8_CE_SHA256))
+		uc_plat->prio[HASH_ALGO_SHA256] = HASH_PRIO_CPU;
+
+	return 0;
+}
+
 static const struct hash_ops hash_ops_sw = {
 	.hash_init = sw_hash_init,
 	.hash_update = sw_hash_update,
@@ -293,6 +312,7 @@ U_BOOT_DRIVER(hash_sw) = {
 	.name = "hash_sw",
 	.id = UCLASS_HASH,
 	.ops = &hash_ops_sw,
+	.bind = sw_hash_bind,
 	.flags = DM_FLAG_PRE_RELOC,
 };
 
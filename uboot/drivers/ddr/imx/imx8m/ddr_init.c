@@ -4,8 +4,10 @@
  */
 
 #include <common.h>
+#include <ddrphy_qb_cache.h>
 #include <errno.h>
 #include <log.h>
+#include <u-boot/crc.h>
 #include <asm/io.h>
 #include <asm/arch/ddr.h>
 #include <asm/arch/clock.h>
@@ -311,6 +313,172 @@ void update_umctl2_rank_space_setting(unsigned int pstat_num)
 	}
 }
 
+#if IS_ENABLED(CONFIG_IMX8M_DDRPHY_QB)
+static u16 ddrphy_qb_read_csr(int idx)
+{
+	return dwc_ddrphy_apb_rd(ddrphy_trained_csr[idx].reg);
+}
+
+static void ddrphy_qb_write_csr(int idx, u16 val)
+{
+	ddrphy_trained_csr[idx].val = val;
+	dwc_ddrphy_apb_wr(ddrphy_trained_csr[idx].reg, val);
+}
+
+static u32 ddrphy_qb_key(struct dram_timing_info *dram_timing)
+{
+	struct dram_fsp_msg *fsp_msg = dram_timing->fsp_msg;
+	u32 key;
+	int i;
+
+	key = crc32(0, (void *)dram_timing->ddrphy_cfg,
+		    dram_timing->ddrphy_cfg_num * sizeof(struct dram_cfg_param));
+	for (i = 0; i < dram_timing->fsp_msg_num; i++, fsp_msg++) {
+		key = crc32(key, (void *)&fsp_msg->drate, sizeof(fsp_msg->drate));
+		key = crc32(key, (void *)fsp_msg->fsp_cfg,
+			    fsp_msg->fsp_cfg_num * sizeof(struct dram_cfg_param));
+	}
+
+	return crc32(key, (void *)&ddrphy_trained_csr_num,
+		     sizeof(ddrphy_trained_csr_num));
+}
+
+/*
+ * Read the saved training results into @buf. The default reads them from
+ * the boot device through the ROM API, at CONFIG_IMX8M_DDRPHY_QB_OFFSET
+ * from the boot image.
+ */
+int __weak board_ddrphy_qb_load(void *buf, size_t size)
+{
+#if IS_ENABLED(CONFIG_SPL_BOOTROM_SUPPORT)
+	u32 boot, offset;
+
+	if (rom_api_query_boot_infor(QUERY_BT_DEV, &boot) != ROM_API_OKAY ||
+	    is_boot_from_stream_device(boot))
+		return -ENODEV;
+	if (rom_api_query_boot_infor(QUERY_IMG_OFF, &offset) != ROM_API_OKAY)
+		return -ENODEV;
+	if (spl_romapi_read(offset + CONFIG_IMX8M_DDRPHY_QB_OFFSET, size,
+			    buf) != size)
+		return -EIO;
+
+	return 0;
+#else
+	return -ENOSYS;
+#endif
+}
+
+/*
+ * Called with new training results after a full training, for boards which
+ * can write them to the boot device from SPL. Otherwise they are left for
+ * U-Boot to store, see imx8m_ddrphy_qb_store().
+ */
+void __weak board_ddrphy_qb_store(const void *buf, size_t size)
+{
+}
+
+static int ddr_cfg_phy_qb(struct dram_timing_info *dram_timing,
+			  const struct ddrphy_qb_cache_ops *ops, u32 key)
+{
+	struct dram_cfg_param *dram_cfg;
+	void *buf = (void *)CONFIG_IMX8M_DDRPHY_QB_SAVE_ADDR;
+	size_t size = ddrphy_qb_cache_size(ops->num_csr);
+	u32 extra[DDRPHY_QB_CACHE_EXTRA];
+	int i, ret;
+
+	ret = board_ddrphy_qb_load(buf, size);
+	if (!ret)
+		ret = ddrphy_qb_cache_check(ops, key, buf, size);
+	if (ret)
+		return ret;
+
+	/* initialize PHY configuration */
+	dram_cfg = dram_timing->ddrphy_cfg;
+	for (i = 0; i < dram_timing->ddrphy_cfg_num; i++, dram_cfg++)
+		dwc_ddrphy_apb_wr(dram_cfg->reg, dram_cfg->val);
+
+	/* leave the PHY clocked as the last training step would */
+	ddrphy_init_set_dfi_clk(dram_timing->fsp_msg[dram_timing->fsp_msg_num - 1].drate);
+
+	/* restore the trained CSRs with the ddrphy apb enabled */
+	dwc_ddrphy_apb_wr(0xd0000, 0x0);
+	dwc_ddrphy_apb_wr(0xc0080, 0x3);
+	ret = ddrphy_qb_cache_restore(ops, key, buf, size, extra);
+	dwc_ddrphy_apb_wr(0xc0080, 0x2);
+	dwc_ddrphy_apb_wr(0xd0000, 0x1);
+	if (ret)
+		return ret;
+
+	/* only new results are left for U-Boot to store */
+	((struct ddrphy_qb_cache_hdr *)buf)->magic = 0;
+
+	memcpy(g_cdd_rr_max, &extra[0], sizeof(g_cdd_rr_max));
+	memcpy(g_cdd_rw_max, &extra[4], sizeof(g_cdd_rw_max));
+	memcpy(g_cdd_wr_max, &extra[8], sizeof(g_cdd_wr_max));
+	memcpy(g_cdd_ww_max, &extra[12], sizeof(g_cdd_ww_max));
+
+	/* Load PHY Init Engine Image */
+	dram_cfg = dram_timing->ddrphy_pie;
+	for (i = 0; i < dram_timing->ddrphy_pie_num; i++, dram_cfg++)
+		dwc_ddrphy_apb_wr(dram_cfg->reg, dram_cfg->val);
+
+	return 0;
+}
+
+static void ddrphy_qb_save(const struct ddrphy_qb_cache_ops *ops, u32 key)
+{
+	void *buf = (void *)CONFIG_IMX8M_DDRPHY_QB_SAVE_ADDR;
+	u32 extra[DDRPHY_QB_CACHE_EXTRA];
+	int ret;
+
+	memcpy(&extra[0], g_cdd_rr_max, sizeof(g_cdd_rr_max));
+	memcpy(&extra[4], g_cdd_rw_max, sizeof(g_cdd_rw_max));
+	memcpy(&extra[8], g_cdd_wr_max, sizeof(g_cdd_wr_max));
+	memcpy(&extra[12], g_cdd_ww_max, sizeof(g_cdd_ww_max));
+
+	dwc_ddrphy_apb_wr(0xd0000, 0x0);
+	dwc_ddrphy_apb_wr(0xc0080, 0x3);
+	ret = ddrphy_qb_cache_save(ops, key, extra, buf,
+				   ddrphy_qb_cache_size(ops->num_csr));
+	dwc_ddrphy_apb_wr(0xc0080, 0x2);
+	dwc_ddrphy_apb_wr(0xd0000, 0x1);
+
+	printf("DDRINFO: ddrphy training results saved at 0x%x, %d bytes\n",
+	       CONFIG_IMX8M_DDRPHY_QB_SAVE_ADDR, ret);
+	board_ddrphy_qb_store(buf, ret);
+}
+
+static int ddr_cfg_phy_trained(struct dram_timing_info *dram_timing)
+{
+	struct ddrphy_qb_cache_ops ops = {
+		.num_csr = ddrphy_trained_csr_num,
+		.read_csr = ddrphy_qb_read_csr,
+		.write_csr = ddrphy_qb_write_csr,
+	};
+	u32 key = ddrphy_qb_key(dram_timing);
+	int ret;
+
+	ret = ddr_cfg_phy_qb(dram_timing, &ops, key);
+	if (!ret) {
+		printf("DDRINFO: ddrphy training skipped\n");
+		return 0;
+	}
+	printf("DDRINFO: no usable ddrphy training results (%d)\n", ret);
+
+	ret = ddr_cfg_phy(dram_timing);
+	if (ret)
+		return ret;
+	ddrphy_qb_save(&ops, key);
+
+	return 0;
+}
+#else
+static int ddr_cfg_phy_trained(struct dram_timing_info *dram_timing)
+{
+	return ddr_cfg_phy(dram_timing);
+}
+#endif
+
 int ddr_init(struct dram_timing_info *dram_timing)
 {
 	unsigned int tmp, initial_drate, target_freq;
@@ -392,7 +560,7 @@ int ddr_init(struct dram_timing_info *dram_timing)
 	 */
 	debug("DDRINFO:ddrphy config start\n");
 
-	ret = ddr_cfg_phy(dram_timing);
+	ret = ddr_cfg_phy_trained(dram_timing);
 	if (ret)
 		return ret;
 
@@ -38,6 +38,7 @@
 #include <mapmem.h>
 #include <dm/ofnode.h>
 #include <linux/iopoll.h>
+#include <linux/sizes.h>
 #include <linux/dma-mapping.h>
 #if CONFIG_IS_ENABLED(IMX_MODULE_FUSE)
 #include <asm/mach-imx/sys_proto.h>
@@ -1604,6 +1605,13 @@ static int fsl_esdhc_probe(struct udevice *dev)
 
 	upriv->mmc = mmc;
 
+#if CONFIG_IS_ENABLED(BLK_DMA_BOUNCE)
+	/* SDMA takes 32-bit addresses and the caches work on whole lines */
+	if (mmc_get_blk_desc(mmc))
+		blk_set_dma_limits(mmc_get_blk_desc(mmc), ARCH_DMA_MINALIGN,
+				   SZ_4G - 1);
+#endif
+
 	return 0;
 }
 
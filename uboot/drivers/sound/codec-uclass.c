@@ -25,4 +25,5 @@ int audio_codec_set_params(struct udevice *dev, int interface, int rate,
 UCLASS_DRIVER(audio_codec) = {
 	.id		= UCLASS_AUDIO_CODEC,
 	.name		= "audio-codec",
+	.flags		= DM_UC_FLAG_LAZY_BIND,
 };
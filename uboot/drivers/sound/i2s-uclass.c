@@ -23,5 +23,6 @@ int i2s_tx_data(struct udevice *dev, void *data, uint data_size)
 UCLASS_DRIVER(i2s) = {
 	.id		= UCLASS_I2S,
 	.name		= "i2s",
+	.flags		= DM_UC_FLAG_LAZY_BIND,
 	.per_device_auto	= sizeof(struct i2s_uc_priv),
 };
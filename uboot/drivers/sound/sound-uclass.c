@@ -174,5 +174,6 @@ int sound_find_codec_i2s(struct udevice *dev)
 UCLASS_DRIVER(sound) = {
 	.id		= UCLASS_SOUND,
 	.name		= "sound",
+	.flags		= DM_UC_FLAG_LAZY_BIND,
 	.per_device_auto	= sizeof(struct sound_uc_priv),
 };
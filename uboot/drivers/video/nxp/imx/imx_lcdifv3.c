@@ -331,7 +331,6 @@ static int lcdifv3_video_probe(struct udevice *dev)
 	struct ctfb_res_modes mode;
 	struct display_timing timings;
 
-	u32 fb_start, fb_end;
 	int ret;
 
 	debug("%s() plat: base 0x%lx, size 0x%x\n",
@@ -396,13 +395,12 @@ static int lcdifv3_video_probe(struct udevice *dev)
 	uc_priv->xsize = mode.xres;
 	uc_priv->ysize = mode.yres;
 
-	/* Enable dcache for the frame buffer */
-	fb_start = plat->base & ~(MMU_SECTION_SIZE - 1);
-	fb_end = plat->base + plat->size;
-	fb_end = ALIGN(fb_end, 1 << MMU_SECTION_SHIFT);
-	mmu_set_region_dcache_behaviour(fb_start, fb_end - fb_start,
-					DCACHE_WRITEBACK);
-	video_set_flush_dcache(dev, true);
+	/*
+	 * Map the frame buffer write-combined, so that stores to it go out in
+	 * bursts without the whole of it being flushed on each sync
+	 */
+	mmu_set_region_dcache_behaviour(plat->base, plat->size,
+					DCACHE_WRITECOMBINE);
 	gd->fb_base = plat->base;
 
 	return ret;
@@ -412,8 +410,13 @@ static int lcdifv3_video_bind(struct udevice *dev)
 {
 	struct video_uc_plat *plat = dev_get_uclass_plat(dev);
 
-	/* Max size supported by LCDIF, because in bind, we can't probe panel */
-	plat->size = 1920 * 1080 *4 * 2;
+	/*
+	 * Max size supported by LCDIF, because in bind, we can't probe panel.
+	 * Keep it in whole 2 MiB blocks, so that mapping it write-combined
+	 * neither splits them nor touches its neighbours.
+	 */
+	plat->size = ALIGN(1920 * 1080 * 4 * 2, MMU_SECTION_SIZE);
+	plat->align = MMU_SECTION_SIZE;
 
 	return 0;
 }
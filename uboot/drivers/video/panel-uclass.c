@@ -52,4 +52,5 @@ int panel_get_display_timing(struct udevice *dev,
 UCLASS_DRIVER(panel) = {
 	.id		= UCLASS_PANEL,
 	.name		= "panel",
+	.flags		= DM_UC_FLAG_LAZY_BIND,
 };
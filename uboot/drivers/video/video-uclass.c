@@ -546,7 +546,7 @@ static int video_post_bind(struct udevice *dev)
 UCLASS_DRIVER(video) = {
 	.id		= UCLASS_VIDEO,
 	.name		= "video",
-	.flags		= DM_UC_FLAG_SEQ_ALIAS,
+	.flags		= DM_UC_FLAG_SEQ_ALIAS | DM_UC_FLAG_LAZY_BIND,
 	.post_bind	= video_post_bind,
 	.post_probe	= video_post_probe,
 	.priv_auto	= sizeof(struct video_uc_priv),
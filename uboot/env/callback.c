@@ -91,49 +91,77 @@ static int clear_callback(struct env_entry *entry)
 }
 
 /*
- * Call for each element in the list that associates variables to callbacks
+ * Set the callback of a variable to the one passed in priv, or remove it
  */
-static int set_callback(const char *name, const char *value, void *priv)
+static int set_var_callback(struct env_entry *entry, void *priv)
 {
-	struct env_entry e, *ep;
-	struct env_clbk_tbl *clbkp;
+	struct env_clbk_tbl *clbkp = priv;
 
-	e.key	= name;
-	e.data	= NULL;
-	e.callback = NULL;
-	hsearch_r(e, ENV_FIND, &ep, &env_htab, 0);
-
-	/* does the env variable actually exist? */
-	if (ep != NULL) {
-		/* the assocaition delares no callback, so remove the pointer */
-		if (value == NULL || strlen(value) == 0)
-			ep->callback = NULL;
-		else {
-			/* assign the requested callback */
-			clbkp = find_env_callback(value);
-			if (clbkp != NULL)
+	if (clbkp == NULL)
+		entry->callback = NULL;
+	else
 #if defined(CONFIG_NEEDS_MANUAL_RELOC)
-				ep->callback = clbkp->callback + gd->reloc_off;
+		entry->callback = clbkp->callback + gd->reloc_off;
 #else
-				ep->callback = clbkp->callback;
+		entry->callback = clbkp->callback;
 #endif
-		}
+
+	return 0;
+}
+
+/*
+ * Call for each element in the list that associates variables to callbacks
+ */
+static int set_callback(const char *name, const char *value, void *priv)
+{
+	struct env_clbk_tbl *clbkp = NULL;
+
+	/* the association declares no callback, so remove the pointer */
+	if (value != NULL && strlen(value) != 0) {
+		/* assign the requested callback */
+		clbkp = find_env_callback(value);
+		if (clbkp == NULL)
+			return 0;
 	}
 
+	/* for each env variable the association names */
+	hwalk_name_r(priv, name, set_var_callback, clbkp);
+
 	return 0;
 }
 
+/*
+ * Configure the static and then the dynamic callback bindings
+ */
+static void set_callbacks(struct hsearch_data *htab, const char *list)
+{
+	/* configure any static callback bindings */
+	env_attr_walk(ENV_CALLBACK_LIST_STATIC, set_callback, htab);
+	/* configure any dynamic callback bindings */
+	env_attr_walk(list, set_callback, htab);
+}
+
 static int on_callbacks(const char *name, const char *value, enum env_op op,
 	int flags)
 {
 	/* remove all callbacks */
 	hwalk_r(&env_htab, clear_callback);
 
-	/* configure any static callback bindings */
-	env_attr_walk(ENV_CALLBACK_LIST_STATIC, set_callback, NULL);
-	/* configure any dynamic callback bindings */
-	env_attr_walk(value, set_callback, NULL);
+	set_callbacks(&env_htab, value);
 
 	return 0;
 }
 U_BOOT_ENV_CALLBACK(callbacks, on_callbacks);
+
+#if CONFIG_IS_ENABLED(ENV_BULK_IMPORT)
+void env_callback_init_all(struct hsearch_data *htab)
+{
+	struct env_entry e, *ep;
+
+	e.key = ENV_CALLBACK_VAR;
+	e.data = NULL;
+	hsearch_r(e, ENV_FIND, &ep, htab, 0);
+
+	set_callbacks(htab, ep ? ep->data : NULL);
+}
+#endif
@@ -475,45 +475,70 @@ static int clear_flags(struct env_entry *entry)
 	return 0;
 }
 
+/*
+ * Set the flags of a variable from the flags string passed in priv
+ */
+static int set_var_flags(struct env_entry *entry, void *priv)
+{
+	const char *value = priv;
+
+	/* the flag list is empty, so clear the flags */
+	if (value == NULL || strlen(value) == 0)
+		entry->flags = 0;
+	else
+		/* assign the requested flags */
+		entry->flags = env_parse_flags_to_bin(value);
+
+	return 0;
+}
+
 /*
  * Call for each element in the list that defines flags for a variable
  */
 static int set_flags(const char *name, const char *value, void *priv)
 {
-	struct env_entry e, *ep;
-
-	e.key	= name;
-	e.data	= NULL;
-	hsearch_r(e, ENV_FIND, &ep, &env_htab, 0);
-
-	/* does the env variable actually exist? */
-	if (ep != NULL) {
-		/* the flag list is empty, so clear the flags */
-		if (value == NULL || strlen(value) == 0)
-			ep->flags = 0;
-		else
-			/* assign the requested flags */
-			ep->flags = env_parse_flags_to_bin(value);
-	}
+	/* for each env variable the element names */
+	hwalk_name_r(priv, name, set_var_flags, (void *)value);
 
 	return 0;
 }
 
+/*
+ * Configure the static and then the dynamic flags
+ */
+static void set_all_flags(struct hsearch_data *htab, const char *list)
+{
+	/* configure any static flags */
+	env_attr_walk(ENV_FLAGS_LIST_STATIC, set_flags, htab);
+	/* configure any dynamic flags */
+	env_attr_walk(list, set_flags, htab);
+}
+
 static int on_flags(const char *name, const char *value, enum env_op op,
 	int flags)
 {
 	/* remove all flags */
 	hwalk_r(&env_htab, clear_flags);
 
-	/* configure any static flags */
-	env_attr_walk(ENV_FLAGS_LIST_STATIC, set_flags, NULL);
-	/* configure any dynamic flags */
-	env_attr_walk(value, set_flags, NULL);
+	set_all_flags(&env_htab, value);
 
 	return 0;
 }
 U_BOOT_ENV_CALLBACK(flags, on_flags);
 
+#if CONFIG_IS_ENABLED(ENV_BULK_IMPORT)
+void env_flags_init_all(struct hsearch_data *htab)
+{
+	struct env_entry e, *ep;
+
+	e.key = ENV_FLAGS_VAR;
+	e.data = NULL;
+	hsearch_r(e, ENV_FIND, &ep, htab, 0);
+
+	set_all_flags(htab, ep ? ep->data : NULL);
+}
+#endif
+
 /*
  * Perform consistency checking before creating, overwriting, or deleting an
  * environment variable. Called as a callback function by hsearch_r() and
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Journal of changes to the environment, see env_internal.h
+ */
+
+#include <common.h>
+#include <env.h>
+#include <env_internal.h>
+#include <malloc.h>
+#include <search.h>
+#include <linux/kernel.h>
+#include <linux/stddef.h>
+#include <u-boot/crc.h>
+
+static u32 env_journal_crc(const struct env_journal_rec *rec)
+{
+	return crc32(0, (const void *)&rec->prev,
+		     sizeof(*rec) - offsetof(struct env_journal_rec, prev) +
+		     rec->len);
+}
+
+static bool env_journal_rec_ok(const struct env_journal_rec *rec, ulong space)
+{
+	return rec->magic == ENV_JOURNAL_MAGIC &&
+	       rec->len <= space - sizeof(*rec) &&
+	       rec->crc == env_journal_crc(rec);
+}
+
+/* Export the environment into *@bufp, allocating it if needed */
+static int env_journal_export(char **bufp)
+{
+	if (!*bufp) {
+		*bufp = malloc(ENV_SIZE);
+		if (!*bufp)
+			return -ENOMEM;
+	}
+	if (hexport_r(&env_htab, '\0', 0, bufp, ENV_SIZE, 0, NULL) < 0)
+		return -ENOSPC;
+
+	return 0;
+}
+
+int env_journal_replay(struct env_journal *jnl, const void *buf,
+		       u32 base_crc, int flags)
+{
+	const struct env_journal_rec *rec;
+	u32 prev = base_crc;
+	ulong off = 0;
+	int count = 0;
+	int ret;
+
+	jnl->valid = false;
+	while (off + sizeof(*rec) <= jnl->size) {
+		rec = buf + off;
+		if (!env_journal_rec_ok(rec, jnl->size - off) ||
+		    rec->prev != prev || (off && rec->seq != jnl->seq + 1))
+			break;
+
+		/* The first record only starts the journal */
+		if (off) {
+			if (!himport_r(&env_htab, rec->data, rec->len, '\0',
+				       flags | H_NOCLEAR, 0, 0, NULL))
+				return -EIO;
+			count++;
+		}
+		jnl->seq = rec->seq;
+		prev = rec->crc;
+		off += ALIGN(sizeof(*rec) + rec->len, jnl->blksz);
+	}
+	if (!off)
+		return -ENOENT;
+
+	/* SPL does not save, so needs no record of what is stored */
+	if (!IS_ENABLED(CONFIG_SPL_BUILD)) {
+		ret = env_journal_export(&jnl->snap);
+		if (ret)
+			return ret;
+	}
+	jnl->end = off;
+	jnl->crc = prev;
+	jnl->valid = true;
+
+	return count;
+}
+
+#ifndef CONFIG_SPL_BUILD
+/* Fill in a record holding @len bytes of data, returning its padded size */
+static int env_journal_seal(struct env_journal *jnl,
+			    struct env_journal_rec *rec, u32 prev,
+			    u32 seq, u32 len, ulong off)
+{
+	ulong size = ALIGN(sizeof(*rec) + len, jnl->blksz);
+
+	rec->magic = ENV_JOURNAL_MAGIC;
+	rec->prev = prev;
+	rec->seq = seq;
+	rec->len = len;
+	memset(rec->data + len, '\0', size - sizeof(*rec) - len);
+	rec->crc = env_journal_crc(rec);
+
+	jnl->next_end = off + size;
+	jnl->next_crc = rec->crc;
+
+	return size;
+}
+
+/* Compare the names of two "name=value" entries */
+static int env_journal_namecmp(const char *a, const char *b)
+{
+	size_t alen = strchrnul(a, '=') - a;
+	size_t blen = strchrnul(b, '=') - b;
+	int ret;
+
+	ret = memcmp(a, b, min(alen, blen));
+	if (ret)
+		return ret;
+
+	return alen < blen ? -1 : alen > blen;
+}
+
+/*
+ * Write the entries which differ between two exported environments to @out,
+ * relying on hexport_r() sorting them by name
+ */
+static int env_journal_diff(const char *old, const char *new, char *out,
+			    ulong size)
+{
+	ulong len = 0, n;
+	int cmp;
+
+	while (*old || *new) {
+		if (!*old)
+			cmp = 1;
+		else if (!*new)
+			cmp = -1;
+		else
+			cmp = env_journal_namecmp(old, new);
+
+		if (cmp < 0) {
+			/* Deleted, so write just the name */
+			n = strchrnul(old, '=') - old;
+			if (len + n + 1 > size)
+				return -ENOSPC;
+			memcpy(out + len, old, n);
+			out[len + n] = '\0';
+			len += n + 1;
+		} else if (cmp > 0 || strcmp(old, new)) {
+			n = strlen(new) + 1;
+			if (len + n > size)
+				return -ENOSPC;
+			memcpy(out + len, new, n);
+			len += n;
+		}
+		if (cmp <= 0)
+			old += strlen(old) + 1;
+		if (cmp >= 0)
+			new += strlen(new) + 1;
+	}
+
+	return len;
+}
+
+int env_journal_append(struct env_journal *jnl, void *buf)
+{
+	struct env_journal_rec *rec = buf;
+	ulong space = jnl->size - jnl->end;
+	int ret, len;
+
+	if (space < jnl->blksz)
+		return -ENOSPC;
+
+	/* If the environment is too large, leave env_export() to report it */
+	ret = env_journal_export(&jnl->next);
+	if (ret)
+		return ret;
+
+	len = env_journal_diff(jnl->snap, jnl->next, rec->data,
+			       ALIGN_DOWN(space, jnl->blksz) - sizeof(*rec));
+	if (len <= 0)
+		return len;
+
+	return env_journal_seal(jnl, rec, jnl->crc, jnl->seq + 1, len,
+				jnl->end);
+}
+
+int env_journal_start(struct env_journal *jnl, const env_t *env, void *buf)
+{
+	if (!jnl->next) {
+		jnl->next = malloc(ENV_SIZE);
+		if (!jnl->next)
+			return -ENOMEM;
+	}
+	memcpy(jnl->next, env->data, ENV_SIZE);
+
+	return env_journal_seal(jnl, buf, env->crc, jnl->seq + 1, 0, 0);
+}
+
+void env_journal_commit(struct env_journal *jnl)
+{
+	swap(jnl->snap, jnl->next);
+	jnl->end = jnl->next_end;
+	jnl->crc = jnl->next_crc;
+	jnl->seq++;
+	jnl->valid = true;
+}
+#endif
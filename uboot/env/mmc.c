@@ -53,6 +53,10 @@ DECLARE_GLOBAL_DATA_PTR;
 #define ENV_MMC_HWPART_REDUND	1
 #endif
 
+#if CONFIG_IS_ENABLED(ENV_JOURNAL)
+static struct env_journal env_mmc_jnl;
+#endif
+
 #if CONFIG_IS_ENABLED(OF_CONTROL)
 static inline int mmc_offset_try_partition(const char *str, int copy, s64 *val)
 {
@@ -170,6 +174,40 @@ __weak int mmc_get_env_addr(struct mmc *mmc, int copy, u32 *env_addr)
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(ENV_JOURNAL)
+/*
+ * Get the offset of the journal following an environment copy, checking that
+ * it does not overlap the other copy
+ */
+static int mmc_get_env_journal_addr(struct mmc *mmc, int copy, u32 *jnl_addr)
+{
+	u32 offset, other;
+
+	if (mmc_get_env_addr(mmc, copy, &offset))
+		return -ENOENT;
+	*jnl_addr = offset + CONFIG_ENV_SIZE;
+
+	if (IS_ENABLED(CONFIG_SYS_REDUNDAND_ENVIRONMENT) &&
+	    !IS_ENABLED(ENV_MMC_HWPART_REDUND)) {
+		if (mmc_get_env_addr(mmc, !copy, &other))
+			return -ENOENT;
+		if (other + CONFIG_ENV_SIZE > *jnl_addr &&
+		    other < *jnl_addr + CONFIG_ENV_JOURNAL_SIZE) {
+			printf("Environment journal overlaps redundant copy\n");
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static void env_mmc_journal_init(struct mmc *mmc)
+{
+	env_mmc_jnl.blksz = mmc_get_blk_desc(mmc)->blksz;
+	env_mmc_jnl.size = CONFIG_ENV_JOURNAL_SIZE;
+}
+#endif
+
 #ifdef CONFIG_SYS_MMC_ENV_PART
 __weak uint mmc_get_env_part(struct mmc *mmc)
 {
@@ -249,6 +287,90 @@ static inline int write_env(struct mmc *mmc, unsigned long size,
 	return (n == blk_cnt) ? 0 : -1;
 }
 
+#if CONFIG_IS_ENABLED(ENV_JOURNAL)
+/* Append the changed variables to the journal of the current copy */
+static int env_mmc_append(struct mmc *mmc, int dev)
+{
+	struct env_journal *jnl = &env_mmc_jnl;
+	int ret, copy = 0;
+	u32 offset;
+	void *buf;
+
+	if (!jnl->valid)
+		return -ENOSPC;
+
+	if (IS_ENABLED(CONFIG_SYS_REDUNDAND_ENVIRONMENT) &&
+	    gd->env_valid == ENV_REDUND)
+		copy = 1;
+
+	if (mmc_get_env_journal_addr(mmc, copy, &offset))
+		return -ENOSPC;
+
+	if (IS_ENABLED(ENV_MMC_HWPART_REDUND)) {
+		ret = mmc_set_env_part(mmc, copy + 1);
+		if (ret)
+			return ret;
+	}
+
+	buf = malloc_cache_aligned(jnl->size - jnl->end);
+	if (!buf)
+		return -ENOMEM;
+
+	ret = env_journal_append(jnl, buf);
+	if (ret > 0) {
+		printf("Appending to %sMMC(%d)... ", copy ? "redundant " : "",
+		       dev);
+		if (write_env(mmc, ret, offset + jnl->end, buf)) {
+			puts("failed\n");
+			jnl->valid = false;
+			ret = -EIO;
+		} else {
+			env_journal_commit(jnl);
+			ret = 0;
+		}
+	} else if (!ret) {
+		printf("No changes for %sMMC(%d)... ", copy ? "redundant " : "",
+		       dev);
+	}
+	free(buf);
+
+	return ret;
+}
+
+/* Start a new journal after writing the whole environment to a copy */
+static void env_mmc_journal_start(struct mmc *mmc, int copy, const env_t *env)
+{
+	struct env_journal *jnl = &env_mmc_jnl;
+	u32 offset;
+	void *buf;
+	int ret;
+
+	env_mmc_journal_init(mmc);
+	jnl->valid = false;
+	if (mmc_get_env_journal_addr(mmc, copy, &offset))
+		return;
+
+	buf = malloc_cache_aligned(jnl->blksz);
+	if (!buf)
+		return;
+
+	ret = env_journal_start(jnl, env, buf);
+	if (ret > 0 && !write_env(mmc, ret, offset, buf))
+		env_journal_commit(jnl);
+	free(buf);
+}
+
+static void env_mmc_journal_stop(void)
+{
+	env_mmc_jnl.valid = false;
+}
+#else
+static inline int env_mmc_append(struct mmc *mmc, int dev) {return -ENOSPC; }
+static inline void env_mmc_journal_start(struct mmc *mmc, int copy,
+					 const env_t *env) {}
+static inline void env_mmc_journal_stop(void) {}
+#endif
+
 static int env_mmc_save(void)
 {
 	ALLOC_CACHE_ALIGN_BUFFER(env_t, env_new, 1);
@@ -264,6 +386,11 @@ static int env_mmc_save(void)
 		return 1;
 	}
 
+	/* Only write the whole environment if the journal cannot take it */
+	ret = env_mmc_append(mmc, dev);
+	if (ret != -ENOSPC)
+		goto fini;
+
 	ret = env_export(env_new);
 	if (ret)
 		goto fini;
@@ -292,6 +419,7 @@ static int env_mmc_save(void)
 	}
 
 	ret = 0;
+	env_mmc_journal_start(mmc, copy, env_new);
 
 	if (IS_ENABLED(CONFIG_SYS_REDUNDAND_ENVIRONMENT))
 		gd->env_valid = gd->env_valid == ENV_REDUND ? ENV_VALID : ENV_REDUND;
@@ -334,6 +462,7 @@ static int env_mmc_erase(void)
 		return 1;
 	}
 
+	env_mmc_journal_stop();
 	if (mmc_get_env_addr(mmc, copy, &offset)) {
 		ret = CMD_RET_FAILURE;
 		goto fini;
@@ -379,6 +508,50 @@ static inline int read_env(struct mmc *mmc, unsigned long size,
 	return (n == blk_cnt) ? 0 : -1;
 }
 
+#if CONFIG_IS_ENABLED(ENV_JOURNAL)
+/* Apply the journal following the environment copy which was imported */
+static int env_mmc_replay(struct mmc *mmc, int copy, const env_t *env)
+{
+	struct env_journal *jnl = &env_mmc_jnl;
+	u32 offset;
+	void *buf;
+	int ret;
+
+	env_mmc_journal_init(mmc);
+	jnl->valid = false;
+	if (mmc_get_env_journal_addr(mmc, copy, &offset))
+		return 0;
+
+	if (IS_ENABLED(ENV_MMC_HWPART_REDUND)) {
+		ret = mmc_set_env_part(mmc, copy + 1);
+		if (ret)
+			return ret;
+	}
+
+	buf = malloc_cache_aligned(jnl->size);
+	if (!buf)
+		return -ENOMEM;
+
+	if (read_env(mmc, jnl->size, offset, buf)) {
+		/* The next save writes the whole environment */
+		puts("*** Warning - cannot read environment journal\n");
+		ret = 0;
+	} else {
+		ret = env_journal_replay(jnl, buf, env->crc, H_EXTERNAL);
+		if (ret == -ENOENT)
+			ret = 0;
+	}
+	free(buf);
+
+	return ret < 0 ? ret : 0;
+}
+#else
+static inline int env_mmc_replay(struct mmc *mmc, int copy, const env_t *env)
+{
+	return 0;
+}
+#endif
+
 #if defined(ENV_IS_EMBEDDED)
 static int env_mmc_load(void)
 {
@@ -431,6 +604,14 @@ static int env_mmc_load(void)
 
 	ret = env_import_redund((char *)tmp_env1, read1_fail, (char *)tmp_env2,
 				read2_fail, H_EXTERNAL);
+	if (!ret) {
+		if (gd->env_valid == ENV_REDUND)
+			ret = env_mmc_replay(mmc, 1, tmp_env2);
+		else
+			ret = env_mmc_replay(mmc, 0, tmp_env1);
+		if (ret)
+			errmsg = "journal import failed";
+	}
 
 fini:
 	fini_mmc_for_env(mmc);
@@ -474,6 +655,9 @@ static int env_mmc_load(void)
 	if (!ret) {
 		ep = (env_t *)buf;
 		gd->env_addr = (ulong)&ep->data;
+		ret = env_mmc_replay(mmc, 0, ep);
+		if (ret)
+			errmsg = "journal import failed";
 	}
 
 fini:
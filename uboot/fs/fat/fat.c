@@ -259,7 +259,9 @@ get_cluster(fsdata *mydata, __u32 clustnum, __u8 *buffer, unsigned long size)
 
 	debug("gc - clustnum: %d, startsect: %d\n", clustnum, startsect);
 
-	if ((unsigned long)buffer & (ARCH_DMA_MINALIGN - 1)) {
+	/* The block layer bounces misaligned buffers itself, if it can */
+	if ((unsigned long)buffer & (ARCH_DMA_MINALIGN - 1) &&
+	    !blk_dma_bounces(cur_dev)) {
 		ALLOC_CACHE_ALIGN_BUFFER(__u8, tmpbuf, mydata->sect_size);
 
 		debug("FAT: Misaligned buffer address (%p)\n", buffer);
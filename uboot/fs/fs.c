@@ -567,11 +567,14 @@ static int fs_read_lmb_check(const char *filename, ulong addr, loff_t offset,
 	lmb_init_and_reserve(&lmb, gd->bd, (void *)gd->fdt_blob);
 	lmb_dump_all(&lmb);
 
-	if (lmb_alloc_addr(&lmb, addr, read_len) == addr)
-		return 0;
+	ret = 0;
+	if (lmb_alloc_addr(&lmb, addr, read_len) != addr) {
+		log_err("** Reading file would overwrite reserved memory **\n");
+		ret = -ENOSPC;
+	}
+	lmb_uninit(&lmb);
 
-	log_err("** Reading file would overwrite reserved memory **\n");
-	return -ENOSPC;
+	return ret;
 }
 #endif
 
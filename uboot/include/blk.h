@@ -84,6 +84,14 @@ struct blk_desc {
 	 * device. Once these functions are removed we can drop this field.
 	 */
 	struct udevice *bdev;
+	/*
+	 * Buffers the device can transfer to directly, as declared with
+	 * blk_set_dma_limits(), and the transfers which had to be bounced
+	 */
+	ulong		dma_align;	/* buffer address/size alignment, or 0 */
+	phys_addr_t	dma_limit;	/* highest buffer address, or 0 */
+	ulong		bounces;	/* number of transfers bounced */
+	u64		bounce_bytes;	/* bytes copied through the bounce */
 #else
 	unsigned long	(*block_read)(struct blk_desc *block_dev,
 				      lbaint_t start,
@@ -503,8 +511,44 @@ const char *blk_get_devtype(struct udevice *dev);
  */
 struct blk_desc *blk_get_by_device(struct udevice *dev);
 
+/**
+ * blk_set_dma_limits() - Declare which buffers a device can transfer to
+ *
+ * With CONFIG_BLK_DMA_BOUNCE, blk_read() and blk_write() pass any other
+ * buffer through a bounce buffer, a chunk at a time, so that the driver only
+ * sees buffers it can DMA to.
+ *
+ * @desc: Block device descriptor
+ * @align: Alignment needed for the address and size of a buffer, or 0
+ * @limit: Highest address the device can reach, or 0 for any
+ */
+static inline void blk_set_dma_limits(struct blk_desc *desc, ulong align,
+				      phys_addr_t limit)
+{
+	desc->dma_align = align;
+	desc->dma_limit = limit;
+}
+
+/**
+ * blk_dma_bounces() - Check whether transfers for a device are bounced
+ *
+ * Return: true if blk_read() and blk_write() take any buffer for @desc and
+ *	   bounce the ones its DMA cannot reach
+ */
+static inline bool blk_dma_bounces(struct blk_desc *desc)
+{
+	return CONFIG_IS_ENABLED(BLK_DMA_BOUNCE) &&
+		(desc->dma_align || desc->dma_limit);
+}
+
 #else
 #include <errno.h>
+
+static inline bool blk_dma_bounces(struct blk_desc *desc)
+{
+	return false;
+}
+
 /*
  * These functions should take struct udevice instead of struct blk_desc,
  * but this is convenient for migration to driver model. Add a 'd' prefix
@@ -211,6 +211,8 @@ enum bootstage_id {
 	BOOTSTAGE_ID_ACCUM_FSP_M,
 	BOOTSTAGE_ID_ACCUM_FSP_S,
 	BOOTSTAGE_ID_ACCUM_MMAP_SPI,
+	BOOTSTAGE_ID_ACCUM_DM_BIND,
+	BOOTSTAGE_ID_ACCUM_IMAGE_COPY,
 
 	/* a few spare for the user, from here */
 	BOOTSTAGE_ID_USER,
@@ -331,6 +333,18 @@ uint32_t bootstage_start(enum bootstage_id id, const char *name);
  */
 uint32_t bootstage_accum(enum bootstage_id id);
 
+/**
+ * Mark the end of a bootstage activity which handled some data
+ *
+ * This is bootstage_accum() for an activity such as copying an image. It
+ * also adds up the bytes handled, which the report shows beside the time.
+ *
+ * @param id	Bootstage id to record this timestamp against
+ * @param size	Number of bytes handled in this iteration of the activity
+ * Return: time spent in this iteration of the activity
+ */
+uint32_t bootstage_accum_size(enum bootstage_id id, ulong size);
+
 /* Print a report about boot time */
 void bootstage_report(void);
 
@@ -430,6 +444,11 @@ static inline uint32_t bootstage_accum(enum bootstage_id id)
 	return 0;
 }
 
+static inline uint32_t bootstage_accum_size(enum bootstage_id id, ulong size)
+{
+	return 0;
+}
+
 static inline int bootstage_stash(void *base, int size)
 {
 	return 0;	/* Pretend to succeed */
@@ -452,6 +471,90 @@ static inline int bootstage_init(bool first)
 
 #endif /* ENABLE_BOOTSTAGE */
 
+/* Types of span recorded by the boot profiler */
+enum bootstage_span_type {
+	BOOTSTAGE_SPAN_INITCALL,	/* Function in an initcall list */
+	BOOTSTAGE_SPAN_PROBE,		/* device_probe() */
+	BOOTSTAGE_SPAN_POST_PROBE,	/* Uclass post_probe() method */
+
+	BOOTSTAGE_SPAN_TYPE_COUNT,
+};
+
+#if defined(ENABLE_BOOTSTAGE) && CONFIG_IS_ENABLED(BOOTSTAGE_PROFILE)
+/**
+ * bootstage_span_start() - Start timing a span of the boot
+ *
+ * Spans nest: a span started before the previous one ends is recorded as
+ * its child, so that the time spent in the span itself can be separated
+ * from the time spent in the spans it contains. The name is copied, and
+ * truncated if needed.
+ *
+ * @type: Type of span
+ * @name: Name of the span, e.g. the device name
+ * Return: span number to pass to bootstage_span_end(), or -1 if bootstage
+ *	is not set up yet
+ */
+int bootstage_span_start(enum bootstage_span_type type, const char *name);
+
+/**
+ * bootstage_span_start_addr() - Start timing a span named by an address
+ *
+ * This is used for initcalls, where the only name available is the address
+ * of the function. Look this up in u-boot.map or System.map.
+ *
+ * @type: Type of span
+ * @addr: Address to use as the name, normally before relocation
+ * Return: span number to pass to bootstage_span_end(), or -1 if bootstage
+ *	is not set up yet
+ */
+int bootstage_span_start_addr(enum bootstage_span_type type, ulong addr);
+
+/**
+ * bootstage_span_end() - Finish timing a span of the boot
+ *
+ * @span: Span number returned by bootstage_span_start(), -1 to do nothing
+ */
+void bootstage_span_end(int span);
+
+/* Print the time taken by each span, and by each span less its children */
+void bootstage_profile_report(void);
+
+/**
+ * bootstage_profile_chrome() - Write the profile as a Chrome trace
+ *
+ * This writes a JSON object in the Trace Event Format, which can be loaded
+ * into chrome://tracing or https://ui.perfetto.dev . Each span is a complete
+ * event and each bootstage mark is an instant event, with times in
+ * microseconds since reset. A span which has not finished yet, such as the
+ * initcall which runs the command line, ends at the current time.
+ *
+ * As with snprintf(), the output is truncated if @size is too small, but
+ * the full length is returned.
+ *
+ * @buf: Buffer to write to, may be NULL if @size is 0
+ * @size: Size of buffer in bytes
+ * Return: length of the trace in bytes, not including the nul terminator,
+ *	or -ENOENT if bootstage is not set up
+ */
+int bootstage_profile_chrome(char *buf, int size);
+#else
+static inline int bootstage_span_start(enum bootstage_span_type type,
+				       const char *name)
+{
+	return -1;
+}
+
+static inline int bootstage_span_start_addr(enum bootstage_span_type type,
+					    ulong addr)
+{
+	return -1;
+}
+
+static inline void bootstage_span_end(int span)
+{
+}
+#endif
+
 /* Helper macro for adding a bootstage to a line of code */
 #define BOOTSTAGE_MARKER()	\
 		bootstage_mark_code(__FILE__, __func__, __LINE__)
@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Saved DDR PHY training results, used to skip PHY training on later boots
+ */
+
+#ifndef __DDRPHY_QB_CACHE_H
+#define __DDRPHY_QB_CACHE_H
+
+#include <linux/types.h>
+
+#define DDRPHY_QB_CACHE_MAGIC	0x38425144	/* "DQB8" */
+#define DDRPHY_QB_CACHE_EXTRA	16
+
+/**
+ * struct ddrphy_qb_cache_hdr - header of saved training results
+ *
+ * The header is followed by @num_csr 16-bit values, one per trained CSR.
+ *
+ * @magic:	DDRPHY_QB_CACHE_MAGIC
+ * @crc:	CRC32 of what follows this field, up to the last CSR value
+ * @key:	Identifies the DRAM timing the PHY was trained with
+ * @num_csr:	Number of CSR values
+ * @extra:	SoC-specific training results which are not PHY CSRs
+ */
+struct ddrphy_qb_cache_hdr {
+	u32 magic;
+	u32 crc;
+	u32 key;
+	u32 num_csr;
+	u32 extra[DDRPHY_QB_CACHE_EXTRA];
+};
+
+/**
+ * struct ddrphy_qb_cache_ops - access to the trained PHY CSRs
+ *
+ * The caller enables APB access to the PHY before saving or restoring.
+ *
+ * @num_csr:	Number of trained CSRs
+ * @read_csr:	Read trained CSR @idx from the PHY
+ * @write_csr:	Write @val to trained CSR @idx of the PHY
+ */
+struct ddrphy_qb_cache_ops {
+	int num_csr;
+	u16 (*read_csr)(int idx);
+	void (*write_csr)(int idx, u16 val);
+};
+
+/**
+ * ddrphy_qb_cache_size() - Get the size of saved training results
+ *
+ * @num_csr:	Number of trained CSRs
+ * Return: number of bytes needed to save them
+ */
+static inline size_t ddrphy_qb_cache_size(int num_csr)
+{
+	return sizeof(struct ddrphy_qb_cache_hdr) + num_csr * sizeof(u16);
+}
+
+/**
+ * ddrphy_qb_cache_save() - Save the trained CSRs after a full training
+ *
+ * @ops:	CSR access
+ * @key:	Identifies the DRAM timing in use
+ * @extra:	DDRPHY_QB_CACHE_EXTRA words to save alongside, or NULL
+ * @buf:	Buffer to write to
+ * @size:	Size of @buf
+ * Return: number of bytes written, -ENOSPC if @buf is too small
+ */
+int ddrphy_qb_cache_save(const struct ddrphy_qb_cache_ops *ops, u32 key,
+			 const u32 *extra, void *buf, size_t size);
+
+/**
+ * ddrphy_qb_cache_check() - Check saved training results
+ *
+ * @ops:	CSR access
+ * @key:	Identifies the DRAM timing in use
+ * @buf:	Saved training results
+ * @size:	Size of @buf
+ * Return: 0 if the results can be restored, -ENOENT if @buf holds none,
+ * -EBADMSG if they are corrupted, -ESTALE if they were saved for another
+ * DRAM timing, -EINVAL if they do not match the CSRs of @ops
+ */
+int ddrphy_qb_cache_check(const struct ddrphy_qb_cache_ops *ops, u32 key,
+			  const void *buf, size_t size);
+
+/**
+ * ddrphy_qb_cache_saved_size() - Get the size of intact training results
+ *
+ * This checks @buf without knowing the PHY, e.g. before writing it out.
+ *
+ * @buf:	Saved training results
+ * @size:	Size of @buf
+ * Return: number of bytes used in @buf, -ENOENT if it holds no results,
+ * -EINVAL if they do not fit in @size, -EBADMSG if they are corrupted
+ */
+int ddrphy_qb_cache_saved_size(const void *buf, size_t size);
+
+/**
+ * ddrphy_qb_cache_restore() - Write saved training results to the PHY
+ *
+ * Nothing is written unless ddrphy_qb_cache_check() passes, so on error
+ * the caller can fall back to a full training.
+ *
+ * @ops:	CSR access
+ * @key:	Identifies the DRAM timing in use
+ * @buf:	Saved training results
+ * @size:	Size of @buf
+ * @extra:	Returns the DDRPHY_QB_CACHE_EXTRA saved words, or NULL
+ * Return: 0 if OK, -ve on error as for ddrphy_qb_cache_check()
+ */
+int ddrphy_qb_cache_restore(const struct ddrphy_qb_cache_ops *ops, u32 key,
+			    const void *buf, size_t size, u32 *extra);
+
+#endif
@@ -13,10 +13,12 @@
 #include <event.h>
 #include <linker_lists.h>
 #include <dm/ofnode.h>
+#include <dm/uclass-id.h>
 
 struct device_node;
 struct driver_info;
 struct udevice;
+struct uclass;
 
 /*
  * These two macros DM_DEVICE_INST and DM_DEVICE_REF are only allowed in code
@@ -437,4 +439,76 @@ static inline int device_notify(const struct udevice *dev, enum event_t type)
 	return 0;
 #endif
 }
+
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+/**
+ * dm_lazy_bind_defer() - Decide whether to leave a node unbound for now
+ *
+ * This is called for each node found while scanning the devicetree after
+ * relocation. A node is deferred, together with everything below it, if it
+ * has a 'u-boot,lazy-bind' property or its driver's uclass has
+ * DM_UC_FLAG_LAZY_BIND.
+ *
+ * @parent: Device the node would be bound to
+ * @node: Node to check
+ * Return: true if the node was recorded to be bound later, false to bind it
+ *	now
+ */
+bool dm_lazy_bind_defer(struct udevice *parent, ofnode node);
+
+/**
+ * dm_lazy_bind_uclass() - Bind deferred nodes of a uclass
+ *
+ * Binds each deferred subtree holding a node whose driver is in uclass @uc
+ *
+ * @uc: Uclass being looked up
+ */
+void dm_lazy_bind_uclass(struct uclass *uc);
+
+/**
+ * dm_lazy_bind_node() - Bind a deferred node
+ *
+ * Binds the deferred subtree holding @node, if any
+ *
+ * @node: Node being looked up
+ */
+void dm_lazy_bind_node(ofnode node);
+
+/**
+ * dm_lazy_bind_children() - Bind deferred children of a device
+ *
+ * @parent: Device whose children are being looked up
+ */
+void dm_lazy_bind_children(const struct udevice *parent);
+
+/**
+ * dm_lazy_bind_drop() - Forget deferred children of a device
+ *
+ * This is called when @parent is unbound
+ *
+ * @parent: Device being unbound
+ */
+void dm_lazy_bind_drop(struct udevice *parent);
+
+/**
+ * dm_lazy_bind_drop_uclass() - Forget deferred nodes of a uclass
+ *
+ * This is called when @uc is destroyed. Each deferred subtree holding a node
+ * in @uc is forgotten.
+ *
+ * @uc: Uclass being destroyed
+ */
+void dm_lazy_bind_drop_uclass(struct uclass *uc);
+#else
+static inline bool dm_lazy_bind_defer(struct udevice *parent, ofnode node)
+{
+	return false;
+}
+
+static inline void dm_lazy_bind_uclass(struct uclass *uc) {}
+static inline void dm_lazy_bind_node(ofnode node) {}
+static inline void dm_lazy_bind_children(const struct udevice *parent) {}
+static inline void dm_lazy_bind_drop(struct udevice *parent) {}
+static inline void dm_lazy_bind_drop_uclass(struct uclass *uc) {}
+#endif
 #endif
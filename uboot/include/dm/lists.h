@@ -45,6 +45,20 @@ struct uclass_driver *lists_uclass_lookup(enum uclass_id id);
  */
 int lists_bind_drivers(struct udevice *parent, bool pre_reloc_only);
 
+/**
+ * lists_driver_lookup_compat() - Find the driver for a compatible string
+ *
+ * This returns the first driver in the linker list with @compat in its
+ * of_match table. With DM_COMPAT_INDEX this is a binary search in an index
+ * built on first use, otherwise all drivers are checked in turn.
+ *
+ * @compat:	Compatible string to look up
+ * @idp:	Returns the matching entry of the driver's of_match table
+ * Return: driver, or NULL if none matches
+ */
+struct driver *lists_driver_lookup_compat(const char *compat,
+					  const struct udevice_id **idp);
+
 /**
  * lists_bind_fdt() - bind a device tree node
  *
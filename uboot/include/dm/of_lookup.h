@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Phandle and path lookup tables for the control devicetree
+ */
+
+#ifndef _DM_OF_LOOKUP_H
+#define _DM_OF_LOOKUP_H
+
+#include <dm/ofnode.h>
+
+#if CONFIG_IS_ENABLED(OF_LOOKUP_CACHE)
+/**
+ * of_lookup_phandle() - Look up a phandle in the control devicetree
+ *
+ * This uses a table from phandle to node, built on first use after
+ * relocation and built again when the flat tree moves or changes size. A
+ * node found in the table is checked to have @phandle before it is
+ * returned.
+ *
+ * @phandle:	Phandle to look up
+ * Return: node with that phandle, or ofnode_null() if the table does not
+ *	have it, in which case the caller must search the tree
+ */
+ofnode of_lookup_phandle(uint phandle);
+
+/**
+ * of_lookup_path() - Look up a path or alias in the control devicetree
+ *
+ * This uses a hash table holding the full path of each node and each
+ * alias, built along with the phandle table. A node found in the table is
+ * checked to still have the full path, or for an alias that the alias still
+ * refers to that path. Paths with options (after a ':') or with an alias
+ * followed by more path components are not handled.
+ *
+ * @path:	Full path of the node, or an alias
+ * Return: node, or ofnode_null() if the table does not have it, in which
+ *	case the caller must search the tree
+ */
+ofnode of_lookup_path(const char *path);
+#else
+static inline ofnode of_lookup_phandle(uint phandle)
+{
+	return ofnode_null();
+}
+
+static inline ofnode of_lookup_path(const char *path)
+{
+	return ofnode_null();
+}
+#endif
+
+#endif
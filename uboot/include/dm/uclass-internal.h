@@ -337,6 +337,20 @@ int uclass_get_count(void);
  */
 struct uclass *uclass_find(enum uclass_id key);
 
+/**
+ * uclass_find_or_add() - Get a uclass, creating it if needed
+ *
+ * This is uclass_get() without binding devices which were left unbound by
+ * CONFIG_DM_LAZY_BIND. It is used when binding a device, so that the other
+ * members of its uclass are not bound along with it.
+ *
+ * @id:		Id to look up
+ * @ucp:	Returns pointer to uclass (there is only one per ID)
+ * Return: 0 if OK, -EDEADLK if driver model is not yet inited, other -ve on
+ *	other error
+ */
+int uclass_find_or_add(enum uclass_id id, struct uclass **ucp);
+
 /**
  * uclass_destroy() - Destroy a uclass
  *
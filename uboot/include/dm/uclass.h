@@ -30,12 +30,17 @@
  * @dev_head: List of devices in this uclass (devices are attached to their
  * uclass when their bind method is called)
  * @sibling_node: Next uclass in the linked list of uclasses
+ * @lazy_head: List of devicetree nodes for this uclass which are waiting to be
+ * bound (see dm_lazy_bind_defer())
  */
 struct uclass {
 	void *priv_;
 	struct uclass_driver *uc_drv;
 	struct list_head dev_head;
 	struct list_head sibling_node;
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+	struct list_head lazy_head;
+#endif
 };
 
 struct driver;
@@ -50,6 +55,9 @@ struct udevice;
 /* Same as DM_FLAG_ALLOC_PRIV_DMA */
 #define DM_UC_FLAG_ALLOC_PRIV_DMA		(1 << 5)
 
+/* The boot does not need members of this uclass, bind them on first use */
+#define DM_UC_FLAG_LAZY_BIND			(1 << 6)
+
 /**
  * struct uclass_driver - Driver for the uclass
  *
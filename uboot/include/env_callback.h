@@ -84,6 +84,11 @@
 
 #ifndef CONFIG_SPL_BUILD
 void env_callback_init(struct env_entry *var_entry);
+/*
+ * Initialize the callbacks of all variables of a table imported in bulk, from
+ * the static list and the ".callbacks" variable of the table
+ */
+void env_callback_init_all(struct hsearch_data *htab);
 #else
 static inline void env_callback_init(struct env_entry *var_entry)
 {
@@ -168,6 +168,12 @@ int env_flags_validate_env_set_params(char *name, char *const val[], int count);
  */
 void env_flags_init(struct env_entry *var_entry);
 
+/*
+ * Initialize the flags of all variables of a table imported in bulk, from the
+ * static list and the ".flags" variable of the table
+ */
+void env_flags_init_all(struct hsearch_data *htab);
+
 /*
  * Validate the newval for to conform with the requirements defined by its flags
  */
@@ -260,6 +260,125 @@ const char *env_fat_get_intf(void);
  * Return: string of device and partition
  */
 char *env_fat_get_dev_part(void);
+
+/*
+ * Environment journal
+ *
+ * With CONFIG_ENV_JOURNAL, a journal area follows each copy of the
+ * environment on the storage. It holds a list of records, each aligned to a
+ * block. The first record has no data and ties the journal to the
+ * environment copy before it, by holding the CRC of that copy. Each following
+ * record holds the variables which changed since the previous one, as
+ * "name=value" for new values and "name" for deleted variables, so that
+ * 'saveenv' only writes those. When the journal is full, the whole
+ * environment is written again and a new journal is started.
+ *
+ * Since the environment copy itself keeps the usual format, tools which only
+ * read that see the environment as it was when the journal was started.
+ * SPL and fw_printenv replay the journal as well.
+ */
+
+#define ENV_JOURNAL_MAGIC	0x4c4e524a	/* "JRNL" */
+
+/**
+ * struct env_journal_rec - a record in the environment journal
+ *
+ * @magic: ENV_JOURNAL_MAGIC
+ * @crc: CRC32 of the fields after this one and the data
+ * @prev: CRC32 of the environment copy, for the first record, else @crc of
+ *	the previous record
+ * @seq: Sequence number, one more than that of the previous record
+ * @len: Number of bytes of data
+ * @data: Changed variables
+ */
+struct env_journal_rec {
+	uint32_t magic;
+	uint32_t crc;
+	uint32_t prev;
+	uint32_t seq;
+	uint32_t len;
+	char data[];
+};
+
+/**
+ * struct env_journal - state of the environment journal of a location
+ *
+ * The location driver sets @blksz and @size before using the journal.
+ *
+ * @blksz: Size of the blocks records are aligned to
+ * @size: Size of the journal area in bytes
+ * @valid: true if the journal area holds the records up to @end
+ * @end: Offset of the next record in the journal area
+ * @crc: @crc of the last record
+ * @seq: @seq of the last record
+ * @snap: Environment as stored, exported by hexport_r()
+ * @next: Environment being saved, exported by hexport_r()
+ * @next_end: Value of @end once the record being saved is written
+ * @next_crc: Value of @crc once the record being saved is written
+ */
+struct env_journal {
+	ulong blksz;
+	ulong size;
+	bool valid;
+	ulong end;
+	uint32_t crc;
+	uint32_t seq;
+	char *snap;
+	char *next;
+	ulong next_end;
+	uint32_t next_crc;
+};
+
+/**
+ * env_journal_replay() - apply the records of a journal to the environment
+ *
+ * This is called after importing the environment copy which the journal
+ * follows. On success the journal is valid, so that later changes can be
+ * appended to it.
+ *
+ * @jnl: Journal state
+ * @buf: Contents of the journal area
+ * @base_crc: CRC32 of the environment copy
+ * @flags: Flags for himport_r() (H_... - see search.h)
+ * Return: number of records applied, -ENOENT if the journal was not started
+ *	for this copy, other -ve on error
+ */
+int env_journal_replay(struct env_journal *jnl, const void *buf,
+		       uint32_t base_crc, int flags);
+
+/**
+ * env_journal_append() - set up a record of the changed variables
+ *
+ * The record is to be written at offset @jnl->end in the journal area, then
+ * env_journal_commit() called.
+ *
+ * @jnl: Journal state, which must be valid
+ * @buf: Buffer for the record, of @jnl->size - @jnl->end bytes
+ * Return: number of bytes to write, 0 if nothing changed, -ENOSPC if the
+ *	record does not fit, so the whole environment must be written, other
+ *	-ve on error
+ */
+int env_journal_append(struct env_journal *jnl, void *buf);
+
+/**
+ * env_journal_start() - set up the first record of a new journal
+ *
+ * The record is to be written at the start of the journal area following
+ * @env, after @env itself, then env_journal_commit() called.
+ *
+ * @jnl: Journal state
+ * @env: Environment copy being written, from env_export()
+ * @buf: Buffer for the record, of @jnl->blksz bytes
+ * Return: number of bytes to write, -ve on error
+ */
+int env_journal_start(struct env_journal *jnl, const env_t *env, void *buf);
+
+/**
+ * env_journal_commit() - note that a record has been written
+ *
+ * @jnl: Journal state
+ */
+void env_journal_commit(struct env_journal *jnl);
 #endif /* DO_DEPS_ONLY */
 
 #endif /* _ENV_INTERNAL_H_ */
@@ -761,6 +761,20 @@ int boot_relocate_fdt(struct lmb *lmb, char **of_flat_tree, ulong *of_size);
 
 int boot_ramdisk_high(struct lmb *lmb, ulong rd_data, ulong rd_len,
 		  ulong *initrd_start, ulong *initrd_end);
+
+/**
+ * boot_ramdisk_in_place() - Check if a ramdisk can be booted where it is
+ *
+ * This is the case if "initrd_high" is ~0, or with
+ * CONFIG_SYS_BOOT_RAMDISK_IN_PLACE if the ramdisk lies below initrd_high in
+ * memory not reserved in @lmb. boot_ramdisk_high() copies it otherwise.
+ *
+ * @lmb: LMB holding the memory reserved so far
+ * @rd_data: Address of the ramdisk data
+ * @rd_len: Length of the ramdisk data in bytes
+ * Return: true if the ramdisk is not copied, false if it is
+ */
+bool boot_ramdisk_in_place(struct lmb *lmb, ulong rd_data, ulong rd_len);
 int boot_get_cmdline(struct lmb *lmb, ulong *cmd_start, ulong *cmd_end);
 int boot_get_kbd(struct lmb *lmb, struct bd_info **kbd);
 
@@ -1271,6 +1285,7 @@ static inline int fit_config_verify(const void *fit, int conf_noffset)
 }
 #endif
 int fit_all_image_verify(const void *fit);
+int fit_conf_image_verify(const void *fit, int conf_noffset);
 int fit_config_decrypt(const void *fit, int conf_noffset);
 int fit_image_check_os(const void *fit, int noffset, uint8_t os);
 int fit_image_check_arch(const void *fit, int noffset, uint8_t arch);
@@ -1383,6 +1398,34 @@ int fit_check_ramdisk(const void *fit, int os_noffset,
 int calculate_hash(const void *data, int data_len, const char *algo,
 			uint8_t *value, int *value_len);
 
+/**
+ * fit_image_set_hash() - supply the digest of image data computed elsewhere
+ *
+ * A loader which hashes an image while reading it can hand over the digest,
+ * so that the next check of a hash node with algorithm @algo in image node
+ * @noffset of @fit, over exactly @data and @size, compares against @value
+ * instead of hashing the data again. The digest is used once.
+ *
+ * @fit:	FIT the image belongs to
+ * @noffset:	Offset of the image node
+ * @data:	Image data
+ * @size:	Size of @data
+ * @algo:	Hash algorithm name, e.g. "sha256"; must stay valid
+ * @value:	Digest of @data
+ * @value_len:	Length of @value, at most FIT_MAX_HASH_LEN
+ */
+void fit_image_set_hash(const void *fit, int noffset, const void *data,
+			size_t size, const char *algo, const uint8_t *value,
+			int value_len);
+
+/**
+ * fit_image_clear_hash() - drop a digest supplied by fit_image_set_hash()
+ *
+ * A loader calls this before reading an image, so that a digest left over
+ * from an earlier read that was never checked cannot be used.
+ */
+void fit_image_clear_hash(void);
+
 /*
  * At present we only support signing on the host, and verification on the
  * device
@@ -8,6 +8,7 @@
 
 typedef int (*init_fnc_t)(void);
 
+#include <bootstage.h>
 #include <log.h>
 #ifdef CONFIG_EFI_APP
 #include <efi.h>
@@ -25,7 +26,7 @@ static inline int initcall_run_list(const init_fnc_t init_sequence[])
 
 	for (init_fnc_ptr = init_sequence; *init_fnc_ptr; ++init_fnc_ptr) {
 		unsigned long reloc_ofs = 0;
-		int ret;
+		int ret, span;
 
 		/*
 		 * Sandbox is relocated by the OS, so symbols always appear at
@@ -43,7 +44,10 @@ static inline int initcall_run_list(const init_fnc_t init_sequence[])
 		else
 			debug("initcall: %p\n", (char *)*init_fnc_ptr - reloc_ofs);
 
+		span = bootstage_span_start_addr(BOOTSTAGE_SPAN_INITCALL,
+						 (ulong)*init_fnc_ptr - reloc_ofs);
 		ret = (*init_fnc_ptr)();
+		bootstage_span_end(span);
 		if (ret) {
 			printf("initcall sequence %p failed at call %p (err=%d)\n",
 			       init_sequence,
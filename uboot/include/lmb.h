@@ -40,7 +40,8 @@ struct lmb_property {
  *
  * @cnt: Number of regions.
  * @max: Size of the region array, max value of cnt.
- * @region: Array of the region properties
+ * @region: Array of the region properties, sorted by base address
+ * @alloced: true if @region has been moved to malloc() space (LMB_DYNAMIC)
  */
 struct lmb_region {
 	unsigned long cnt;
@@ -50,6 +51,9 @@ struct lmb_region {
 #else
 	struct lmb_property *region;
 #endif
+#if IS_ENABLED(CONFIG_LMB_DYNAMIC)
+	bool alloced;
+#endif
 };
 
 /**
@@ -62,7 +66,8 @@ struct lmb_region {
  *
  * @memory: Description of memory regions.
  * @reserved: Description of reserved regions.
- * @memory_regions: Array of the memory regions (statically allocated)
+ * @memory_regions: Array of the memory regions (statically allocated). With
+ *	LMB_DYNAMIC this only holds the first regions
  * @reserved_regions: Array of the reserved regions (statically allocated)
  */
 struct lmb {
@@ -75,6 +80,17 @@ struct lmb {
 };
 
 void lmb_init(struct lmb *lmb);
+
+/**
+ * lmb_uninit() - Free the region lists and empty them
+ *
+ * With LMB_DYNAMIC the lists move to malloc() space once they outgrow the
+ * arrays in struct lmb. Call this when finished with a struct lmb which may
+ * have grown.
+ *
+ * @lmb:	the logical memory block struct
+ */
+void lmb_uninit(struct lmb *lmb);
 void lmb_init_and_reserve(struct lmb *lmb, struct bd_info *bd, void *fdt_blob);
 void lmb_init_and_reserve_range(struct lmb *lmb, phys_addr_t base,
 				phys_size_t size, void *fdt_blob);
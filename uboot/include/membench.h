@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Advanced SIMD primitives for the 'membench' command
+ */
+
+#ifndef __MEMBENCH_H
+#define __MEMBENCH_H
+
+#include <linux/types.h>
+
+/* Size of the blocks the primitives work on, one cache line */
+#define MEMBENCH_LINE		64
+
+/*
+ * Each primitive handles @size bytes, a non-zero multiple of MEMBENCH_LINE,
+ * a cache line at a time. @dst and @src are only used where the name says.
+ */
+void membench_simd_read(void *dst, const void *src, ulong size);
+void membench_simd_write(void *dst, const void *src, ulong size);
+void membench_simd_copy(void *dst, const void *src, ulong size);
+
+#endif /* __MEMBENCH_H */
@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Memory test engine for 'mtest -p'
+ */
+
+#ifndef __MEMTEST_H
+#define __MEMTEST_H
+
+#include <linux/types.h>
+
+/* Size of the blocks the test works on, one cache line */
+#define MEMTEST_LINE		64
+#define MEMTEST_LINE_WORDS	(MEMTEST_LINE / sizeof(u64))
+
+/* Number of errors recorded in detail for each part */
+#define MEMTEST_MAX_FAILS	4
+
+/**
+ * struct memtest_fail - an error found by the memory test
+ *
+ * @addr: Address of the word
+ * @expected: Value written
+ * @actual: Value read back. If this equals @expected, the line containing
+ *	the word read back wrong once but right when it was checked again
+ */
+struct memtest_fail {
+	ulong addr;
+	u64 expected;
+	u64 actual;
+};
+
+/**
+ * struct memtest_part - part of the memory range, tested by one CPU
+ *
+ * @addr: Address of the part
+ * @buf: Pointer to the part
+ * @size: Size of the part in bytes, a multiple of MEMTEST_LINE
+ * @seed: Background pattern for the moving inversions test
+ * @local: true if the part is tested on the CPU which started the test, so
+ *	that it may call schedule()
+ * @errs: Number of errors found
+ * @nfails: Number of entries in @fails
+ * @fails: First errors found
+ * @bytes: Number of bytes read and written
+ * @ticks: Time taken, in get_ticks() units
+ * @done: Set when the part has been tested
+ */
+struct memtest_part {
+	ulong addr;
+	void *buf;
+	ulong size;
+	u64 seed;
+	bool local;
+	ulong errs;
+	int nfails;
+	struct memtest_fail fails[MEMTEST_MAX_FAILS];
+	u64 bytes;
+	u64 ticks;
+	bool done;
+};
+
+/**
+ * memtest_part() - run the memory test on one part
+ *
+ * This runs the address-in-address, walking ones and moving inversions tests
+ * over the part and fills in its results. It does not print anything, so it
+ * may run on any CPU.
+ *
+ * @part: Part to test
+ */
+void memtest_part(struct memtest_part *part);
+
+/**
+ * memtest_run() - test several parts at once
+ *
+ * Part 0 is tested on this CPU. Each other part is tested on the CPU of the
+ * same number if it can be started, otherwise on this CPU after part 0.
+ *
+ * @parts: Parts to test
+ * @count: Number of parts, at most memtest_cpu_count()
+ * Return: number of CPUs used
+ */
+int memtest_run(struct memtest_part *parts, int count);
+
+/**
+ * memtest_cpu_count() - get the number of CPUs which can run the test
+ *
+ * Return: number of CPUs, including this one
+ */
+int memtest_cpu_count(void);
+
+/**
+ * memtest_cpu_call() - start running a function on another CPU
+ *
+ * The CPU runs @func with the MMU and caches set up as on this CPU, then turns
+ * itself off. @func must not print or call schedule(), and has to tell this
+ * CPU when it is done.
+ *
+ * @cpu: CPU number, from 1 to memtest_cpu_count() - 1
+ * @func: Function to run
+ * @arg: Argument of @func
+ * Return: 0 if OK, -ve on error
+ */
+int memtest_cpu_call(int cpu, void (*func)(void *arg), void *arg);
+
+/**
+ * memtest_cpu_start() - start testing a part on another CPU
+ *
+ * The CPU calls memtest_part() and then sets @part->done.
+ *
+ * @cpu: CPU number, from 1 to memtest_cpu_count() - 1
+ * @part: Part to test
+ * Return: 0 if OK, -ve on error
+ */
+int memtest_cpu_start(int cpu, struct memtest_part *part);
+
+/**
+ * memtest_cpu_wait() - wait for a CPU to finish testing its part
+ *
+ * @cpu: CPU number passed to memtest_cpu_start()
+ * @part: Part being tested
+ */
+void memtest_cpu_wait(int cpu, struct memtest_part *part);
+
+/*
+ * Test primitives, which an architecture may provide faster versions of.
+ * Each works on @size bytes at @buf, a multiple of MEMTEST_LINE. @line gives
+ * the values of the first line; each following line has @incr added to every
+ * word.
+ */
+
+/* Write the lines */
+void memtest_fill(void *buf, ulong size, const u64 *line, u64 incr);
+
+/* Check the lines, returning the offset of the first bad one, or @size */
+ulong memtest_check(const void *buf, ulong size, const u64 *line, u64 incr);
+
+/*
+ * Going up, check that each line holds @line and write its inverse, returning
+ * the offset of the first bad line, or @size
+ */
+ulong memtest_inv_up(void *buf, ulong size, const u64 *line);
+
+/*
+ * Going down, check that each line holds the inverse of @line and write
+ * @line, returning the offset of the first bad line, or @size
+ */
+ulong memtest_inv_down(void *buf, ulong size, const u64 *line);
+
+#endif
@@ -47,6 +47,12 @@ struct hsearch_data {
 	struct env_entry_node *table;
 	unsigned int size;
 	unsigned int filled;
+/*
+ * Text of the last import in bulk, which the keys and data of the entries it
+ * created point into (see himport_r())
+ */
+	char *pool;
+	size_t pool_size;
 /*
  * Callback function which will check whether the given change for variable
  * "item" to "newval" may be applied or not, and possibly apply such change.
@@ -107,6 +113,15 @@ int himport_r(struct hsearch_data *htab, const char *env, size_t size,
 int hwalk_r(struct hsearch_data *htab,
 	    int (*callback)(struct env_entry *entry));
 
+/*
+ * Call the callback on each entry named "name" or, with CONFIG_REGEX, on each
+ * entry whose whole name is matched by "name" taken as a regular expression.
+ * Stops at the first non-zero return value of the callback, and returns it.
+ */
+int hwalk_name_r(struct hsearch_data *htab, const char *name,
+		 int (*callback)(struct env_entry *entry, void *priv),
+		 void *priv);
+
 /* Flags for himport_r(), hexport_r(), hdelete_r(), and hsearch_r() */
 #define H_NOCLEAR	(1 << 0) /* do not clear hash table before importing */
 #define H_FORCE		(1 << 1) /* overwrite read-only/write-once variables */
@@ -123,5 +138,6 @@ int hwalk_r(struct hsearch_data *htab,
 #define H_ORIGIN_FLAGS	(H_INTERACTIVE | H_PROGRAMMATIC)
 #define H_DEFAULT	(1 << 10) /* indicate that an import is default env */
 #define H_EXTERNAL	(1 << 11) /* indicate that an import is external env */
+#define H_BULK		(1 << 12) /* enter entries from an import in bulk    */
 
 #endif /* _SEARCH_H_ */
@@ -249,6 +249,7 @@ struct spl_image_info {
 	uintptr_t entry_point;
 #if CONFIG_IS_ENABLED(LOAD_FIT) || CONFIG_IS_ENABLED(LOAD_FIT_FULL)
 	void *fdt_addr;
+	uintptr_t atf_entry;	/* Entry of an ATF loadable, 0 if none */
 #endif
 	u32 boot_device;
 	u32 offset;
@@ -19,6 +19,35 @@ enum HASH_ALGO {
 	HASH_ALGO_INVALID = 0xffffffff,
 };
 
+/**
+ * enum hash_prio - How fast a device computes a given algorithm
+ *
+ * When several hash devices support the same algorithm, the one with the
+ * lowest non-zero value is preferred by hash_get_device().
+ *
+ * @HASH_PRIO_NONE: Algorithm is not supported by the device
+ * @HASH_PRIO_HW: Dedicated hardware engine, e.g. CAAM
+ * @HASH_PRIO_CPU: CPU instructions, e.g. ARMv8 Crypto Extensions
+ * @HASH_PRIO_SW: Generic software implementation
+ */
+enum hash_prio {
+	HASH_PRIO_NONE,
+	HASH_PRIO_HW,
+	HASH_PRIO_CPU,
+	HASH_PRIO_SW,
+};
+
+/**
+ * struct hash_uc_plat - uclass platform data for hash devices
+ *
+ * Drivers fill this in from their bind() method.
+ *
+ * @prio: Priority of the device for each algorithm (enum hash_prio)
+ */
+struct hash_uc_plat {
+	u8 prio[HASH_ALGO_NUM];
+};
+
 /* general APIs for hash algo information */
 enum HASH_ALGO hash_algo_lookup_by_name(const char *name);
 ssize_t hash_algo_digest_size(enum HASH_ALGO algo);
@@ -35,6 +64,50 @@ int hash_init(struct udevice *dev, enum HASH_ALGO algo, void **ctxp);
 int hash_update(struct udevice *dev, void *ctx, const void *ibuf, const uint32_t ilen);
 int hash_finish(struct udevice *dev, void *ctx, void *obuf);
 
+/**
+ * hash_get_device() - Get the fastest device supporting an algorithm
+ *
+ * Devices are tried in the order given by their enum hash_prio for @algo,
+ * so a hardware engine is used when present, then CPU-accelerated code,
+ * then the generic software implementation.
+ *
+ * @algo: Algorithm required
+ * @devp: Returns the probed device
+ * Return: 0 if OK, -ENODEV if no device supports @algo, other -ve on error
+ */
+int hash_get_device(enum HASH_ALGO algo, struct udevice **devp);
+
+/**
+ * hash_digest_start() - Start hashing a buffer without waiting for the result
+ *
+ * Queues an all-in-one hash operation so that the CPU can carry on with other
+ * work while the device hashes @ibuf. The result is not valid until
+ * hash_digest_wait() has returned successfully. Devices which cannot work
+ * asynchronously compute the digest immediately.
+ *
+ * @dev: Hash device
+ * @algo: Algorithm to use
+ * @ibuf: Input buffer, which must not be changed until the request completes
+ * @ilen: Length of @ibuf in bytes
+ * @obuf: Output buffer for the digest
+ * @reqp: Returns the request handle to pass to hash_digest_wait()
+ * Return: 0 if OK, -ve on error
+ */
+int hash_digest_start(struct udevice *dev, enum HASH_ALGO algo,
+		      const void *ibuf, const uint32_t ilen, void *obuf,
+		      void **reqp);
+
+/**
+ * hash_digest_wait() - Wait for a request started by hash_digest_start()
+ *
+ * The request handle is released, whatever the result.
+ *
+ * @dev: Hash device
+ * @req: Request handle from hash_digest_start()
+ * Return: 0 if OK (digest written to the output buffer), -ve on error
+ */
+int hash_digest_wait(struct udevice *dev, void *req);
+
 /*
  * struct hash_ops - Driver model for Hash operations
  *
@@ -56,6 +129,12 @@ struct hash_ops {
 	int (*hash_digest_wd)(struct udevice *dev, enum HASH_ALGO algo,
 			      const void *ibuf, const uint32_t ilen,
 			      void *obuf, uint32_t chunk_sz);
+
+	/* asynchronous all-in-one operation, optional */
+	int (*hash_digest_start)(struct udevice *dev, enum HASH_ALGO algo,
+				 const void *ibuf, const uint32_t ilen,
+				 void *obuf, void **reqp);
+	int (*hash_digest_wait)(struct udevice *dev, void *req);
 };
 
 #endif
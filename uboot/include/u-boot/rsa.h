@@ -100,6 +100,23 @@ int rsa_verify(struct image_sign_info *info,
 int rsa_verify_with_pkey(struct image_sign_info *info,
 			 const void *hash, uint8_t *sig, uint sig_len);
 
+/**
+ * rsa_key_cache_flush() - Drop all cached public key properties
+ *
+ * Keys used for verification are parsed once and kept for later
+ * signatures. Call this when the key material may have changed.
+ *
+ * Return: number of cache entries released
+ */
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(RSA_KEY_CACHE)
+int rsa_key_cache_flush(void);
+#else
+static inline int rsa_key_cache_flush(void)
+{
+	return 0;
+}
+#endif
+
 int padding_pkcs_15_verify(struct image_sign_info *info,
 			   const uint8_t *msg, int msg_len,
 			   const uint8_t *hash, int hash_len);
@@ -22,6 +22,30 @@ void sha256_finish(sha256_context * ctx, uint8_t digest[SHA256_SUM_LEN]);
 void sha256_csum_wd(const unsigned char *input, unsigned int ilen,
 		unsigned char *output, unsigned int chunk_sz);
 
+/*
+ * struct sha256_mb_job - one message for sha256_csum_mb()
+ *
+ * @input: message
+ * @ilen: length of @input in bytes
+ * @output: receives the SHA256_SUM_LEN byte digest
+ */
+struct sha256_mb_job {
+	const unsigned char *input;
+	unsigned int ilen;
+	unsigned char *output;
+};
+
+/* Hash several independent messages, interleaving the work between them */
+void sha256_csum_mb(const struct sha256_mb_job *jobs, unsigned int count);
+
+/*
+ * Process @blocks whole blocks of two messages at once. May be overridden
+ * by an accelerated version.
+ */
+void sha256_process_x2(sha256_context *ctx0, const unsigned char *data0,
+		       sha256_context *ctx1, const unsigned char *data1,
+		       unsigned int blocks);
+
 void sha256_hmac(const unsigned char *key, int keylen,
 		const unsigned char *input, unsigned int ilen,
 		unsigned char *output);
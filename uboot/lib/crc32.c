@@ -186,6 +186,27 @@ uint32_t __efi_runtime crc32_no_comp(uint32_t crc, const Bytef *buf, uInt len)
 {
 #ifdef CONFIG_ARM64_CRC32
     crc = cpu_to_le32(crc);
+    /* Align it, then feed the crc32x instruction a doubleword at a time */
+    while (len && ((uintptr_t)buf & 7)) {
+        crc = __builtin_aarch64_crc32b(crc, *buf++);
+        len--;
+    }
+    while (len >= 32) {
+        const uint64_t *d = (const uint64_t *)buf;
+
+        crc = __builtin_aarch64_crc32x(crc, d[0]);
+        crc = __builtin_aarch64_crc32x(crc, d[1]);
+        crc = __builtin_aarch64_crc32x(crc, d[2]);
+        crc = __builtin_aarch64_crc32x(crc, d[3]);
+        buf += 32;
+        len -= 32;
+    }
+    while (len >= 8) {
+        crc = __builtin_aarch64_crc32x(crc, *(const uint64_t *)buf);
+        buf += 8;
+        len -= 8;
+    }
+    /* And the last few bytes */
     while (len--)
         crc = __builtin_aarch64_crc32b(crc, *buf++);
     return le32_to_cpu(crc);
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Saved DDR PHY training results, used to skip PHY training on later boots
+ */
+
+#include <common.h>
+#include <ddrphy_qb_cache.h>
+#include <errno.h>
+#include <u-boot/crc.h>
+
+static u32 ddrphy_qb_cache_crc(const struct ddrphy_qb_cache_hdr *hdr)
+{
+	const void *start = &hdr->key;
+
+	return crc32(0, start, ddrphy_qb_cache_size(hdr->num_csr) -
+		     (start - (const void *)hdr));
+}
+
+int ddrphy_qb_cache_save(const struct ddrphy_qb_cache_ops *ops, u32 key,
+			 const u32 *extra, void *buf, size_t size)
+{
+	struct ddrphy_qb_cache_hdr *hdr = buf;
+	u16 *val = buf + sizeof(*hdr);
+	int i;
+
+	if (size < ddrphy_qb_cache_size(ops->num_csr))
+		return -ENOSPC;
+
+	memset(hdr, '\0', sizeof(*hdr));
+	hdr->magic = DDRPHY_QB_CACHE_MAGIC;
+	hdr->key = key;
+	hdr->num_csr = ops->num_csr;
+	if (extra)
+		memcpy(hdr->extra, extra, sizeof(hdr->extra));
+
+	for (i = 0; i < ops->num_csr; i++)
+		val[i] = ops->read_csr(i);
+	hdr->crc = ddrphy_qb_cache_crc(hdr);
+
+	return ddrphy_qb_cache_size(ops->num_csr);
+}
+
+int ddrphy_qb_cache_check(const struct ddrphy_qb_cache_ops *ops, u32 key,
+			  const void *buf, size_t size)
+{
+	const struct ddrphy_qb_cache_hdr *hdr = buf;
+
+	if (size < sizeof(*hdr) || hdr->magic != DDRPHY_QB_CACHE_MAGIC)
+		return -ENOENT;
+	if (hdr->num_csr != ops->num_csr ||
+	    size < ddrphy_qb_cache_size(hdr->num_csr))
+		return -EINVAL;
+	if (hdr->crc != ddrphy_qb_cache_crc(hdr))
+		return -EBADMSG;
+	if (hdr->key != key)
+		return -ESTALE;
+
+	return 0;
+}
+
+int ddrphy_qb_cache_saved_size(const void *buf, size_t size)
+{
+	const struct ddrphy_qb_cache_hdr *hdr = buf;
+
+	if (size < sizeof(*hdr) || hdr->magic != DDRPHY_QB_CACHE_MAGIC)
+		return -ENOENT;
+	if (size < ddrphy_qb_cache_size(hdr->num_csr))
+		return -EINVAL;
+	if (hdr->crc != ddrphy_qb_cache_crc(hdr))
+		return -EBADMSG;
+
+	return ddrphy_qb_cache_size(hdr->num_csr);
+}
+
+int ddrphy_qb_cache_restore(const struct ddrphy_qb_cache_ops *ops, u32 key,
+			    const void *buf, size_t size, u32 *extra)
+{
+	const struct ddrphy_qb_cache_hdr *hdr = buf;
+	const u16 *val = buf + sizeof(*hdr);
+	int i, ret;
+
+	ret = ddrphy_qb_cache_check(ops, key, buf, size);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < ops->num_csr; i++)
+		ops->write_csr(i, val[i]);
+	if (extra)
+		memcpy(extra, hdr->extra, sizeof(hdr->extra));
+
+	return 0;
+}
@@ -59,7 +59,8 @@ static int ecdsa_verify_hash(struct udevice *dev,
 	const struct ecdsa_ops *ops = device_get_ops(dev);
 	const struct checksum_algo *algo = info->checksum;
 	struct ecdsa_public_key key;
-	int sig_node, key_node, ret;
+	int sig_node, key_node, hint_node = -FDT_ERR_NOTFOUND, ret;
+	char name[100];
 
 	if (!ops || !ops->verify)
 		return -ENODEV;
@@ -77,8 +78,25 @@ static int ecdsa_verify_hash(struct udevice *dev,
 	if (sig_node < 0)
 		return -ENOENT;
 
+	/*
+	 * Each failed attempt costs a full verification, so start with the
+	 * key named by the hint, which is normally the one that matches.
+	 */
+	if (info->keyname) {
+		snprintf(name, sizeof(name), "key-%s", info->keyname);
+		hint_node = fdt_subnode_offset(info->fdt_blob, sig_node, name);
+		if (hint_node >= 0 &&
+		    !fdt_get_key(&key, info->fdt_blob, hint_node) &&
+		    !ops->verify(dev, &key, hash, algo->checksum_len,
+				 sig, sig_len))
+			return 0;
+	}
+
 	/* Try all possible keys under the "/signature" node */
 	fdt_for_each_subnode(key_node, info->fdt_blob, sig_node) {
+		if (key_node == hint_node)
+			continue;
+
 		ret = fdt_get_key(&key, info->fdt_blob, key_node);
 		if (ret < 0)
 			continue;
@@ -26,6 +26,7 @@
 #include <asm/sections.h>
 #include <dm/ofnode.h>
 #include <dm/of_extra.h>
+#include <dm/of_lookup.h>
 #include <linux/ctype.h>
 #include <linux/lzo.h>
 #include <linux/ioport.h>
@@ -630,6 +631,20 @@ int fdtdec_check_fdt(void)
 	return 0;
 }
 
+/* Find a node by phandle, using the lookup table for the control FDT */
+static int fdtdec_node_offset_by_phandle(const void *blob, uint32_t phandle)
+{
+	ofnode node;
+
+	if (blob == gd->fdt_blob && !of_live_active()) {
+		node = of_lookup_phandle(phandle);
+		if (ofnode_valid(node))
+			return ofnode_to_offset(node);
+	}
+
+	return fdt_node_offset_by_phandle(blob, phandle);
+}
+
 int fdtdec_lookup_phandle(const void *blob, int node, const char *prop_name)
 {
 	const u32 *phandle;
@@ -640,7 +655,7 @@ int fdtdec_lookup_phandle(const void *blob, int node, const char *prop_name)
 	if (!phandle)
 		return -FDT_ERR_NOTFOUND;
 
-	lookup = fdt_node_offset_by_phandle(blob, fdt32_to_cpu(*phandle));
+	lookup = fdtdec_node_offset_by_phandle(blob, fdt32_to_cpu(*phandle));
 	return lookup;
 }
 
@@ -771,8 +786,8 @@ int fdtdec_parse_phandle_with_args(const void *blob, int src_node,
 			 * below.
 			 */
 			if (cells_name || cur_index == index) {
-				node = fdt_node_offset_by_phandle(blob,
-								  phandle);
+				node = fdtdec_node_offset_by_phandle(blob,
+								     phandle);
 				if (node < 0) {
 					debug("%s: could not find phandle\n",
 					      fdt_get_name(blob, src_node,
@@ -1494,7 +1509,7 @@ int fdtdec_get_carveout(const void *blob, const char *node,
 
 	phandle = fdt32_to_cpu(prop[index]);
 
-	offset = fdt_node_offset_by_phandle(blob, phandle);
+	offset = fdtdec_node_offset_by_phandle(blob, phandle);
 	if (offset < 0) {
 		debug("failed to find node for phandle %u\n", phandle);
 		return offset;
@@ -63,6 +63,15 @@ struct env_entry_node {
 static void _hdelete(const char *key, struct hsearch_data *htab,
 		     struct env_entry *ep, int idx);
 
+/*
+ * Free a key or data string, unless it lies in the text of an import in bulk
+ */
+static void hfree(struct hsearch_data *htab, const char *str)
+{
+	if (str < htab->pool || str >= htab->pool + htab->pool_size)
+		free((void *)str);
+}
+
 /*
  * hcreate()
  */
@@ -153,11 +162,14 @@ void hdestroy_r(struct hsearch_data *htab)
 		if (htab->table[i].used > 0) {
 			struct env_entry *ep = &htab->table[i].entry;
 
-			free((void *)ep->key);
-			free(ep->data);
+			hfree(htab, ep->key);
+			hfree(htab, ep->data);
 		}
 	}
 	free(htab->table);
+	free(htab->pool);
+	htab->pool = NULL;
+	htab->pool_size = 0;
 
 	/* the sign for an existing table is an value != NULL in htable */
 	htab->table = NULL;
@@ -243,7 +255,11 @@ static inline int _compare_and_overwrite_entry(struct env_entry item,
 	if (htab->table[idx].used == hval
 	    && strcmp(item.key, htab->table[idx].entry.key) == 0) {
 		/* Overwrite existing value? */
-		if (action == ENV_ENTER && item.data) {
+		if (action == ENV_ENTER && item.data && (flag & H_BULK)) {
+			/* A later entry of the text of an import in bulk */
+			hfree(htab, htab->table[idx].entry.data);
+			htab->table[idx].entry.data = item.data;
+		} else if (action == ENV_ENTER && item.data) {
 			/* check for permission */
 			if (htab->change_ok != NULL && htab->change_ok(
 			    &htab->table[idx].entry, item.data,
@@ -265,7 +281,7 @@ static inline int _compare_and_overwrite_entry(struct env_entry item,
 				return 0;
 			}
 
-			free(htab->table[idx].entry.data);
+			hfree(htab, htab->table[idx].entry.data);
 			htab->table[idx].entry.data = strdup(item.data);
 			if (!htab->table[idx].entry.data) {
 				__set_errno(ENOMEM);
@@ -381,6 +397,19 @@ int hsearch_r(struct env_entry item, enum env_action action,
 			idx = first_deleted;
 
 		htab->table[idx].used = hval;
+
+		/*
+		 * Keep the strings of an import in bulk in its text, and leave
+		 * the callback, flags and checks to himport_bind()
+		 */
+		if (flag & H_BULK) {
+			htab->table[idx].entry.key = item.key;
+			htab->table[idx].entry.data = item.data;
+			++htab->filled;
+			*retval = &htab->table[idx].entry;
+			return 1;
+		}
+
 		htab->table[idx].entry.key = strdup(item.key);
 		htab->table[idx].entry.data = strdup(item.data);
 		if (!htab->table[idx].entry.key ||
@@ -445,8 +474,8 @@ static void _hdelete(const char *key, struct hsearch_data *htab,
 {
 	/* free used entry */
 	debug("hdelete: DELETING key \"%s\"\n", key);
-	free((void *)ep->key);
-	free(ep->data);
+	hfree(htab, ep->key);
+	hfree(htab, ep->data);
 	ep->flags = 0;
 	htab->table[idx].used = USED_DELETED;
 
@@ -752,6 +781,50 @@ static int drop_var_from_set(const char *name, int nvars, char * vars[])
 	return res;
 }
 
+#if CONFIG_IS_ENABLED(ENV_BULK_IMPORT)
+/*
+ * Return the length of the used part of NUL separated data, which ends with
+ * an empty entry
+ */
+static size_t himport_len(const char *env, size_t size)
+{
+	size_t len = 0;
+
+	while (len < size && env[len])
+		len += strnlen(env + len, size - len) + 1;
+
+	return len < size ? len : size;
+}
+
+/*
+ * Look up the callbacks and flags of the entries created by an import in bulk
+ * by walking the lists which bind them once, then run the checks and callbacks
+ * which hsearch_r() runs for each new entry
+ */
+static void himport_bind(struct hsearch_data *htab, int flag)
+{
+	struct env_entry *ep;
+	int i;
+
+	env_callback_init_all(htab);
+	env_flags_init_all(htab);
+
+	for (i = 1; i <= htab->size; ++i) {
+		if (htab->table[i].used <= 0)
+			continue;
+		ep = &htab->table[i].entry;
+
+		if ((htab->change_ok &&
+		     htab->change_ok(ep, ep->data, env_op_create, flag)) ||
+		    do_callback(ep, ep->key, ep->data, env_op_create, flag)) {
+			printf("himport_r: can't insert \"%s=%s\" into hash table\n",
+			       ep->key, ep->data);
+			_hdelete(ep->key, htab, ep, i);
+		}
+	}
+}
+#endif
+
 /*
  * Import linearized data into hash table.
  *
@@ -796,6 +869,8 @@ int himport_r(struct hsearch_data *htab,
 {
 	char *data, *sp, *dp, *name, *value;
 	char *localvars[nvars];
+	size_t len = size;
+	bool bulk = false;
 	int i;
 
 	/* Test for correct arguments.  */
@@ -804,24 +879,36 @@ int himport_r(struct hsearch_data *htab,
 		return 0;
 	}
 
+#if CONFIG_IS_ENABLED(ENV_APPEND)
+	flag |= H_NOCLEAR;
+#endif
+
+#if CONFIG_IS_ENABLED(ENV_BULK_IMPORT)
+	/*
+	 * A whole environment replacing the table is imported in bulk: the
+	 * entries keep pointing into our copy of it, so only copy what is used
+	 */
+	if (!(flag & H_NOCLEAR) && !nvars) {
+		bulk = true;
+		if (sep == '\0' && !crlf_is_lf)
+			len = himport_len(env, size);
+	}
+#endif
+
 	/* we allocate new space to make sure we can write to the array */
-	if ((data = malloc(size + 1)) == NULL) {
-		debug("himport_r: can't malloc %lu bytes\n", (ulong)size + 1);
+	if ((data = malloc(len + 1)) == NULL) {
+		debug("himport_r: can't malloc %lu bytes\n", (ulong)len + 1);
 		__set_errno(ENOMEM);
 		return 0;
 	}
-	memcpy(data, env, size);
-	data[size] = '\0';
+	memcpy(data, env, len);
+	data[len] = '\0';
 	dp = data;
 
 	/* make a local copy of the list of variables */
 	if (nvars)
 		memcpy(localvars, vars, sizeof(vars[0]) * nvars);
 
-#if CONFIG_IS_ENABLED(ENV_APPEND)
-	flag |= H_NOCLEAR;
-#endif
-
 	if ((flag & H_NOCLEAR) == 0 && !nvars) {
 		/* Destroy old hash table if one exists */
 		debug("Destroy Hash Table: %p table = %p\n", htab,
@@ -879,6 +966,10 @@ int himport_r(struct hsearch_data *htab,
 		size -= ignored_crs;
 		dp = data;
 	}
+	if (bulk) {
+		htab->pool = data;
+		htab->pool_size = len + 1;
+	}
 	/* Parse environment; allow for '\0' and 'sep' as separators */
 	do {
 		struct env_entry e, *rv;
@@ -929,7 +1020,8 @@ int himport_r(struct hsearch_data *htab,
 		if (*name == 0) {
 			debug("INSERT: unable to use an empty key\n");
 			__set_errno(EINVAL);
-			free(data);
+			if (!bulk)
+				free(data);
 			return 0;
 		}
 
@@ -941,7 +1033,7 @@ int himport_r(struct hsearch_data *htab,
 		e.key = name;
 		e.data = value;
 
-		hsearch_r(e, ENV_ENTER, &rv, htab, flag);
+		hsearch_r(e, ENV_ENTER, &rv, htab, bulk ? flag | H_BULK : flag);
 #if !IS_ENABLED(CONFIG_ENV_WRITEABLE_LIST)
 		if (rv == NULL) {
 			printf("himport_r: can't insert \"%s=%s\" into hash table\n",
@@ -954,6 +1046,12 @@ int himport_r(struct hsearch_data *htab,
 			rv, name, value);
 	} while ((dp < data + size) && *dp);	/* size check needed for text */
 						/* without '\0' termination */
+#if CONFIG_IS_ENABLED(ENV_BULK_IMPORT)
+	if (bulk) {
+		himport_bind(htab, flag);
+		goto end;
+	}
+#endif
 	debug("INSERT: free(data = %p)\n", data);
 	free(data);
 
@@ -1006,3 +1104,44 @@ int hwalk_r(struct hsearch_data *htab, int (*callback)(struct env_entry *entry))
 
 	return 0;
 }
+
+/*
+ * Walk the entries named by an entry of an attribute list, which is a regular
+ * expression for the whole name with CONFIG_REGEX (see env/attr.c)
+ */
+int hwalk_name_r(struct hsearch_data *htab, const char *name,
+		 int (*callback)(struct env_entry *entry, void *priv),
+		 void *priv)
+{
+	struct env_entry e, *ep;
+#ifdef CONFIG_REGEX
+	char regex[strlen(name) + 3];
+	struct slre slre;
+	int i, retval;
+
+	if (strpbrk(name, "\\^$.[]|()?*+")) {
+		sprintf(regex, "^%s$", name);
+		if (!slre_compile(&slre, regex)) {
+			printf("Error compiling regex: %s\n", slre.err_str);
+			return -EINVAL;
+		}
+		for (i = 1; i <= htab->size; ++i) {
+			ep = &htab->table[i].entry;
+			if (htab->table[i].used <= 0 ||
+			    !slre_match(&slre, ep->key, strlen(ep->key), NULL))
+				continue;
+			retval = callback(ep, priv);
+			if (retval)
+				return retval;
+		}
+
+		return 0;
+	}
+#endif
+	e.key = name;
+	e.data = NULL;
+	if (!hsearch_r(e, ENV_FIND, &ep, htab, 0))
+		return 0;
+
+	return callback(ep, priv);
+}
@@ -380,6 +380,131 @@ static int rsa_verify_key(struct image_sign_info *info,
 	return 0;
 }
 
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(RSA_KEY_CACHE)
+DECLARE_GLOBAL_DATA_PTR;
+
+#define RSA_KEY_CACHE_SIZE	4
+
+/**
+ * struct rsa_key_cache_entry - DER public key with already parsed properties
+ *
+ * Only keys given as DER blobs (RSA_VERIFY_WITH_PKEY) are cached, since
+ * rsa_gen_key_prop() has to work out n0inv and R^2 from their modulus. The
+ * properties of a key node in an FDT are just read from the node, which
+ * costs next to nothing.
+ *
+ * @der:	Private copy of the DER key
+ * @der_len:	Number of bytes in @der
+ * @prop:	Key properties, allocated by rsa_gen_key_prop()
+ */
+struct rsa_key_cache_entry {
+	void *der;
+	uint32_t der_len;
+	struct key_prop *prop;
+};
+
+static struct rsa_key_cache_entry rsa_key_cache[RSA_KEY_CACHE_SIZE];
+static int rsa_key_cache_next;
+
+static bool rsa_key_cache_usable(void)
+{
+	/* The cache lives in BSS and holds malloc()ed copies */
+	return gd->flags & GD_FLG_FULL_MALLOC_INIT;
+}
+
+static void rsa_key_cache_drop(struct rsa_key_cache_entry *entry)
+{
+	free(entry->der);
+	rsa_free_key_prop(entry->prop);
+	memset(entry, '\0', sizeof(*entry));
+}
+
+int rsa_key_cache_flush(void)
+{
+	int i, count = 0;
+
+	for (i = 0; i < RSA_KEY_CACHE_SIZE; i++) {
+		if (rsa_key_cache[i].prop) {
+			rsa_key_cache_drop(&rsa_key_cache[i]);
+			count++;
+		}
+	}
+	rsa_key_cache_next = 0;
+
+	return count;
+}
+
+/* Take ownership of @der and @prop */
+static void rsa_key_cache_add(void *der, uint32_t der_len,
+			      struct key_prop *prop)
+{
+	struct rsa_key_cache_entry *entry;
+
+	entry = &rsa_key_cache[rsa_key_cache_next];
+	rsa_key_cache_next = (rsa_key_cache_next + 1) % RSA_KEY_CACHE_SIZE;
+	if (entry->prop)
+		rsa_key_cache_drop(entry);
+
+	entry->der = der;
+	entry->der_len = der_len;
+	entry->prop = prop;
+}
+
+/**
+ * rsa_key_cache_get_der() - Look up, or parse and cache, a DER public key
+ *
+ * @key:	DER public key
+ * @keylen:	Number of bytes in @key
+ * @propp:	Returns the key properties, owned by the cache
+ * Return: 0 on success, -ENOENT if the key is not cached and the cache
+ * cannot be used, other -ve on error
+ */
+static int __maybe_unused rsa_key_cache_get_der(const void *key,
+						uint32_t keylen,
+						struct key_prop **propp)
+{
+	struct rsa_key_cache_entry *entry;
+	struct key_prop *prop;
+	void *der;
+	int i, ret;
+
+	if (!rsa_key_cache_usable())
+		return -ENOENT;
+
+	/* The caller's buffer may be reused, so match on contents */
+	for (i = 0; i < RSA_KEY_CACHE_SIZE; i++) {
+		entry = &rsa_key_cache[i];
+		if (entry->der && entry->der_len == keylen &&
+		    !memcmp(entry->der, key, keylen)) {
+			*propp = entry->prop;
+			return 0;
+		}
+	}
+
+	der = malloc(keylen);
+	if (!der)
+		return -ENOENT;
+
+	ret = rsa_gen_key_prop(key, keylen, &prop);
+	if (ret) {
+		free(der);
+		return ret;
+	}
+	memcpy(der, key, keylen);
+	rsa_key_cache_add(der, keylen, prop);
+	*propp = prop;
+
+	return 0;
+}
+
+#else
+static inline int rsa_key_cache_get_der(const void *key, uint32_t keylen,
+					struct key_prop **propp)
+{
+	return -ENOENT;
+}
+#endif
+
 /**
  * rsa_verify_with_pkey() - Verify a signature against some data using
  * only modulus and exponent as RSA key properties.
@@ -403,6 +528,15 @@ int rsa_verify_with_pkey(struct image_sign_info *info,
 	if (!CONFIG_IS_ENABLED(RSA_VERIFY_WITH_PKEY))
 		return -EACCES;
 
+	ret = rsa_key_cache_get_der(info->key, info->keylen, &prop);
+	if (!ret)
+		return rsa_verify_key(info, prop, sig, sig_len, hash,
+				      info->crypto->key_len);
+	if (ret != -ENOENT) {
+		debug("Generating necessary parameter for decoding failed\n");
+		return ret;
+	}
+
 	/* Public key is self-described to fill key_prop */
 	ret = rsa_gen_key_prop(info->key, info->keylen, &prop);
 	if (ret) {
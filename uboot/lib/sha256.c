@@ -200,6 +200,98 @@ __weak void sha256_process(sha256_context *ctx, const unsigned char *data,
 	}
 }
 
+static const uint32_t sha256_k[64] = {
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+	0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+	0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+	0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+	0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+	0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+	0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+	0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+	0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+	0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+	0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+	0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+	0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+	0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+/*
+ * Process one block of two independent messages with their rounds
+ * interleaved, so that an in-order CPU has two dependency chains to issue
+ * from instead of one.
+ */
+static void sha256_process_two(sha256_context *ctx0, const uint8_t *data0,
+			       sha256_context *ctx1, const uint8_t *data1)
+{
+	uint32_t temp1, temp2, temp3, temp4;
+	uint32_t W0[64], W1[64];
+	uint32_t a0, b0, c0, d0, e0, f0, g0, h0;
+	uint32_t a1, b1, c1, d1, e1, f1, g1, h1;
+	int i;
+
+	for (i = 0; i < 16; i++) {
+		GET_UINT32_BE(W0[i], data0, i * 4);
+		GET_UINT32_BE(W1[i], data1, i * 4);
+	}
+	for (i = 16; i < 64; i++) {
+		W0[i] = S1(W0[i - 2]) + W0[i - 7] + S0(W0[i - 15]) + W0[i - 16];
+		W1[i] = S1(W1[i - 2]) + W1[i - 7] + S0(W1[i - 15]) + W1[i - 16];
+	}
+
+#define P2(a,b,c,d,e,f,g,h,t) {						\
+	temp1 = h##0 + S3(e##0) + F1(e##0,f##0,g##0) + sha256_k[t] + W0[t]; \
+	temp3 = h##1 + S3(e##1) + F1(e##1,f##1,g##1) + sha256_k[t] + W1[t]; \
+	temp2 = S2(a##0) + F0(a##0,b##0,c##0);				\
+	temp4 = S2(a##1) + F0(a##1,b##1,c##1);				\
+	d##0 += temp1; h##0 = temp1 + temp2;				\
+	d##1 += temp3; h##1 = temp3 + temp4;				\
+}
+
+	a0 = ctx0->state[0]; a1 = ctx1->state[0];
+	b0 = ctx0->state[1]; b1 = ctx1->state[1];
+	c0 = ctx0->state[2]; c1 = ctx1->state[2];
+	d0 = ctx0->state[3]; d1 = ctx1->state[3];
+	e0 = ctx0->state[4]; e1 = ctx1->state[4];
+	f0 = ctx0->state[5]; f1 = ctx1->state[5];
+	g0 = ctx0->state[6]; g1 = ctx1->state[6];
+	h0 = ctx0->state[7]; h1 = ctx1->state[7];
+
+	for (i = 0; i < 64; i += 8) {
+		P2(a, b, c, d, e, f, g, h, i);
+		P2(h, a, b, c, d, e, f, g, i + 1);
+		P2(g, h, a, b, c, d, e, f, i + 2);
+		P2(f, g, h, a, b, c, d, e, i + 3);
+		P2(e, f, g, h, a, b, c, d, i + 4);
+		P2(d, e, f, g, h, a, b, c, i + 5);
+		P2(c, d, e, f, g, h, a, b, i + 6);
+		P2(b, c, d, e, f, g, h, a, i + 7);
+	}
+
+	ctx0->state[0] += a0; ctx1->state[0] += a1;
+	ctx0->state[1] += b0; ctx1->state[1] += b1;
+	ctx0->state[2] += c0; ctx1->state[2] += c1;
+	ctx0->state[3] += d0; ctx1->state[3] += d1;
+	ctx0->state[4] += e0; ctx1->state[4] += e1;
+	ctx0->state[5] += f0; ctx1->state[5] += f1;
+	ctx0->state[6] += g0; ctx1->state[6] += g1;
+	ctx0->state[7] += h0; ctx1->state[7] += h1;
+}
+
+__weak void sha256_process_x2(sha256_context *ctx0, const unsigned char *data0,
+			      sha256_context *ctx1, const unsigned char *data1,
+			      unsigned int blocks)
+{
+	while (blocks--) {
+		sha256_process_two(ctx0, data0, ctx1, data1);
+		data0 += 64;
+		data1 += 64;
+	}
+}
+
 void sha256_update(sha256_context *ctx, const uint8_t *input, uint32_t length)
 {
 	uint32_t left, fill;
@@ -302,6 +394,56 @@ void sha256_csum_wd(const unsigned char *input, unsigned int ilen,
 	sha256_finish(&ctx, output);
 }
 
+/*
+ * Hash two messages from their start, processing the blocks they have in
+ * common in lock-step.
+ */
+static void sha256_csum_two(const struct sha256_mb_job *job0,
+			    const struct sha256_mb_job *job1)
+{
+	sha256_context ctx0, ctx1;
+	unsigned int len, done, chunk;
+
+	sha256_starts(&ctx0);
+	sha256_starts(&ctx1);
+
+	len = job0->ilen < job1->ilen ? job0->ilen : job1->ilen;
+	len &= ~63U;
+	for (done = 0; done < len; done += chunk) {
+		chunk = len - done;
+		if (chunk > CHUNKSZ_SHA256)
+			chunk = CHUNKSZ_SHA256;
+		sha256_process_x2(&ctx0, job0->input + done,
+				  &ctx1, job1->input + done, chunk / 64);
+#if defined(CONFIG_HW_WATCHDOG) || defined(CONFIG_WATCHDOG)
+		schedule();
+#endif
+	}
+	ctx0.total[0] = len;
+	ctx1.total[0] = len;
+
+	sha256_update(&ctx0, job0->input + len, job0->ilen - len);
+	sha256_update(&ctx1, job1->input + len, job1->ilen - len);
+	sha256_finish(&ctx0, job0->output);
+	sha256_finish(&ctx1, job1->output);
+}
+
+/*
+ * Output[i] = SHA-256( input buffer[i] ) for each job. Jobs are hashed in
+ * pairs, so this is quickest when neighbouring jobs have similar lengths.
+ */
+void sha256_csum_mb(const struct sha256_mb_job *jobs, unsigned int count)
+{
+	unsigned int i;
+
+	for (i = 0; i + 1 < count; i += 2)
+		sha256_csum_two(&jobs[i], &jobs[i + 1]);
+
+	if (i < count)
+		sha256_csum_wd(jobs[i].input, jobs[i].ilen, jobs[i].output,
+			       CHUNKSZ_SHA256);
+}
+
 /*
  * Output = HMAC-SHA-256( input buffer, hmac key )
  */
@@ -31,6 +31,42 @@
 #  define PUP(a) *++(a)
 #endif
 
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+#define CHUNK_SIZE	8
+
+/*
+   Copy len bytes from from to out (both in PUP() convention) a 64-bit word
+   at a time, finishing with a byte-wise tail.  The source must either lie
+   outside the output or be at least CHUNK_SIZE bytes behind out, so that
+   every word is complete before it is read back by an overlapping copy.
+   Never writes past out + len.  Returns the updated out pointer.
+ */
+static inline unsigned char FAR *chunk_copy(unsigned char FAR *out,
+                                            const unsigned char FAR *from,
+                                            unsigned len)
+{
+    out += OFF;
+    from += OFF;
+    while (len >= 2 * CHUNK_SIZE) {
+        put_unaligned(get_unaligned((u64 *)from), (u64 *)out);
+        put_unaligned(get_unaligned((u64 *)(from + CHUNK_SIZE)),
+                      (u64 *)(out + CHUNK_SIZE));
+        out += 2 * CHUNK_SIZE;
+        from += 2 * CHUNK_SIZE;
+        len -= 2 * CHUNK_SIZE;
+    }
+    if (len >= CHUNK_SIZE) {
+        put_unaligned(get_unaligned((u64 *)from), (u64 *)out);
+        out += CHUNK_SIZE;
+        from += CHUNK_SIZE;
+        len -= CHUNK_SIZE;
+    }
+    while (len--)
+        *out++ = *from++;
+    return out - OFF;
+}
+#endif
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -205,9 +241,13 @@ void inflate_fast(z_streamp strm, unsigned start)
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+                            out = chunk_copy(out, from, op);
+#else
                             do {
                                 PUP(out) = PUP(from);
                             } while (--op);
+#endif
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -216,16 +256,24 @@ void inflate_fast(z_streamp strm, unsigned start)
                         op -= write;
                         if (op < len) {         /* some from end of window */
                             len -= op;
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+                            out = chunk_copy(out, from, op);
+#else
                             do {
                                 PUP(out) = PUP(from);
                             } while (--op);
+#endif
                             from = window - OFF;
                             if (write < len) {  /* some from start of window */
                                 op = write;
                                 len -= op;
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+                                out = chunk_copy(out, from, op);
+#else
                                 do {
                                     PUP(out) = PUP(from);
                                 } while (--op);
+#endif
                                 from = out - dist;      /* rest from output */
                             }
                         }
@@ -234,12 +282,22 @@ void inflate_fast(z_streamp strm, unsigned start)
                         from += write - op;
                         if (op < len) {         /* some from window */
                             len -= op;
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+                            out = chunk_copy(out, from, op);
+#else
                             do {
                                 PUP(out) = PUP(from);
                             } while (--op);
+#endif
                             from = out - dist;  /* rest from output */
                         }
                     }
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+                    if (dist >= CHUNK_SIZE) {
+                        out = chunk_copy(out, from, len);
+                        len = 0;
+                    }
+#endif
                     while (len > 2) {
                         PUP(out) = PUP(from);
                         PUP(out) = PUP(from);
@@ -252,6 +310,12 @@ void inflate_fast(z_streamp strm, unsigned start)
                             PUP(out) = PUP(from);
                     }
                 }
+#if CONFIG_IS_ENABLED(ZLIB_CHUNK_COPY)
+                else if (dist >= CHUNK_SIZE) {
+                    /* copy direct from output, no short-period overlap */
+                    out = chunk_copy(out, out - dist, len);
+                }
+#endif
                 else {
 		    unsigned short *sout;
 		    unsigned long loops;
@@ -7,11 +7,21 @@
  */
 
 #include <common.h>
+#include <bootstage.h>
+#include <command.h>
+#include <env.h>
 #include <image.h>
+#include <lmb.h>
+#include <malloc.h>
+#include <mapmem.h>
+#include <asm/global_data.h>
 #include <test/suites.h>
 #include <test/ut.h>
+#include <u-boot/sha256.h>
 #include "bootstd_common.h"
 
+DECLARE_GLOBAL_DATA_PTR;
+
 /* Test of image phase */
 static int test_image_phase(struct unit_test_state *uts)
 {
@@ -34,3 +44,193 @@ static int test_image_phase(struct unit_test_state *uts)
 	return 0;
 }
 BOOTSTD_TEST(test_image_phase, 0);
+
+/* Test that a ramdisk is only copied when it is in the way */
+static int test_image_ramdisk_in_place(struct unit_test_state *uts)
+{
+	ulong base = 0x100000, rd, start, end;
+	struct lmb lmb;
+	char *buf;
+
+	if (!IS_ENABLED(CONFIG_SYS_BOOT_RAMDISK_IN_PLACE))
+		return -EAGAIN;
+
+	buf = map_sysmem(base, 0x10000);
+	lmb_init(&lmb);
+	ut_assertok(lmb_add(&lmb, base, 0x10000));
+	ut_assertok(env_set("initrd_high", "0"));
+
+	/* A ramdisk in free memory is used where it is, and reserved */
+	rd = base + 0x1000;
+	memset(buf + 0x1000, 0xa5, 0x2000);
+	ut_assertok(boot_ramdisk_high(&lmb, rd, 0x2000, &start, &end));
+	ut_asserteq(rd, start);
+	ut_asserteq(rd + 0x2000, end);
+	ut_asserteq(1, lmb_is_reserved(&lmb, rd));
+
+	/* One in reserved memory is copied to the top */
+	ut_assertok(boot_ramdisk_high(&lmb, rd, 0x2000, &start, &end));
+	ut_asserteq(base + 0xe000, start);
+	ut_asserteq_mem(buf + 0x1000, buf + 0xe000, 0x2000);
+
+	/* So is one above initrd_high, to below it */
+	rd = base + 0x8000;
+	memset(buf + 0x8000, 0x5a, 0x2000);
+	ut_assertok(env_set_hex("initrd_high", base + 0x9000));
+	ut_assertok(boot_ramdisk_high(&lmb, rd, 0x2000, &start, &end));
+	ut_asserteq(base + 0x7000, start);
+	ut_asserteq(0x5a, buf[0x7000]);
+	ut_asserteq(0x5a, buf[0x8fff]);
+
+	ut_assertok(env_set("initrd_high", NULL));
+	lmb_uninit(&lmb);
+	unmap_sysmem(buf);
+
+	return 0;
+}
+BOOTSTD_TEST(test_image_ramdisk_in_place, 0);
+
+/*
+ * Write a FIT at @addr holding an image of @type with @size bytes of @fill,
+ * to load at @load if not 0. Set @datap to the address of the data.
+ */
+static int make_fit(struct unit_test_state *uts, ulong addr, int type,
+		    ulong load, ulong size, int fill, ulong *datap)
+{
+	const char *name = genimg_get_type_short_name(type);
+	int images, node, confs, conf;
+	void *fit = map_sysmem(addr, size + 0x1000);
+	void *data;
+
+	ut_assertok(fdt_create_empty_tree(fit, size + 0x1000));
+	ut_assertok(fdt_setprop_string(fit, 0, FIT_DESC_PROP, name));
+	ut_assertok(fdt_setprop_u32(fit, 0, FIT_TIMESTAMP_PROP, 0));
+	images = fdt_add_subnode(fit, 0, "images");
+	ut_assert(images >= 0);
+	node = fdt_add_subnode(fit, images, "image-1");
+	ut_assert(node >= 0);
+	ut_assertok(fdt_setprop_string(fit, node, FIT_TYPE_PROP, name));
+	ut_assertok(fdt_setprop_string(fit, node, FIT_OS_PROP, "linux"));
+	ut_assertok(fdt_setprop_string(fit, node, FIT_ARCH_PROP,
+				       genimg_get_arch_short_name(IH_ARCH_DEFAULT)));
+	ut_assertok(fdt_setprop_string(fit, node, FIT_COMP_PROP, "none"));
+	if (load) {
+		ut_assertok(fdt_setprop_u32(fit, node, FIT_LOAD_PROP, load));
+		ut_assertok(fdt_setprop_u32(fit, node, FIT_ENTRY_PROP, load));
+	}
+	ut_assertok(fdt_setprop_placeholder(fit, node, FIT_DATA_PROP, size,
+					    &data));
+	memset(data, fill, size);
+
+	confs = fdt_add_subnode(fit, 0, "configurations");
+	ut_assert(confs >= 0);
+	ut_assertok(fdt_setprop_string(fit, confs, FIT_DEFAULT_PROP,
+				       "conf-1"));
+	conf = fdt_add_subnode(fit, confs, "conf-1");
+	ut_assert(conf >= 0);
+	ut_assertok(fdt_setprop_string(fit, conf, name, "image-1"));
+
+	node = fdt_path_offset(fit, "/images/image-1");
+	*datap = map_to_sysmem(fdt_getprop(fit, node, FIT_DATA_PROP, NULL));
+	unmap_sysmem(fit);
+
+	return 0;
+}
+
+/* Test where bootm leaves a ramdisk, given the memory it has reserved */
+static int test_image_ramdisk_bootm(struct unit_test_state *uts)
+{
+	struct bootstage_data *old = gd->bootstage;
+	char *line = uts->actual_str;
+	const ulong load = 0x400000;
+	ulong data;
+	char *buf;
+
+	if (!IS_ENABLED(CONFIG_SYS_BOOT_RAMDISK_IN_PLACE))
+		return -EAGAIN;
+
+	/* start with a clean record, to count the bytes copied below */
+	ut_assertok(bootstage_init(true));
+
+	/* a 4KB kernel, which bootm loads to 0x400000 and reserves */
+	ut_assertok(make_fit(uts, 0x100000, IH_TYPE_KERNEL, load, 0x1000,
+			     0x11, &data));
+	ut_assertok(env_set("verify", "n"));
+	ut_assertok(env_set("initrd_high", "0x800000"));
+
+	/* A ramdisk in free memory below initrd_high is not copied */
+	ut_assertok(make_fit(uts, 0x200000, IH_TYPE_RAMDISK, 0, 0x2000, 0x22,
+			     &data));
+	ut_assertok(run_command("bootm start 100000 200000", 0));
+	ut_assertok(run_command("bootm loados", 0));
+	console_record_reset_enable();
+	ut_assertok(run_command("bootm ramdisk", 0));
+	ut_assert_console_end();
+	ut_asserteq(data, images.initrd_start);
+	ut_asserteq(data + 0x2000, images.initrd_end);
+
+	/* One overlapping the kernel as loaded is copied away from it */
+	ut_assertok(make_fit(uts, 0x3ff000, IH_TYPE_RAMDISK, 0, 0x2000, 0x22,
+			     &data));
+	ut_assert(data + 0x2000 > load);
+	ut_assertok(run_command("bootm start 100000 3ff000", 0));
+	ut_assertok(run_command("bootm loados", 0));
+	console_record_reset_enable();
+	ut_assertok(run_command("bootm ramdisk", 0));
+	ut_assert_nextlinen("   Loading Ramdisk to");
+	ut_assert_console_end();
+	ut_assert(images.initrd_end <= load ||
+		  images.initrd_start >= load + 0x1000);
+	ut_assert(images.initrd_end <= 0x800000);
+
+	/* One with a usable load address is loaded there and left there */
+	ut_assertok(make_fit(uts, 0x200000, IH_TYPE_RAMDISK, 0x500000, 0x2000,
+			     0x33, &data));
+	console_record_reset_enable();
+	ut_assertok(run_command("bootm start 100000 200000", 0));
+	ut_assert_skip_to_line("   Loading ramdisk from 0x%08lx to 0x00500000",
+			       data);
+	ut_assertok(run_command("bootm loados", 0));
+	console_record_reset_enable();
+	ut_assertok(run_command("bootm ramdisk", 0));
+	ut_assert_console_end();
+	ut_asserteq(0x500000, images.initrd_start);
+
+	/*
+	 * One in a FIT above initrd_high, with a load address above it too, is
+	 * copied once, straight from the FIT to below initrd_high
+	 */
+	ut_assertok(make_fit(uts, 0xa00000, IH_TYPE_RAMDISK, 0x900000, 0x2000,
+			     0x44, &data));
+	buf = map_sysmem(0x900000, 0x2000);
+	memset(buf, '\0', 0x2000);
+	free(gd->bootstage);
+	ut_assertok(bootstage_init(true));
+	console_record_reset_enable();
+	ut_assertok(run_command("bootm start 100000 a00000", 0));
+	ut_assert_skip_to_line("   Leaving ramdisk at 0x%08lx, 0x00900000 is not usable",
+			       data);
+	ut_assertok(run_command("bootm loados", 0));
+	console_record_reset_enable();
+	ut_assertok(run_command("bootm ramdisk", 0));
+	ut_assert_nextlinen("   Loading Ramdisk to");
+	ut_assert_console_end();
+	ut_assert(images.initrd_end <= 0x800000);
+	ut_asserteq(0x44, *(char *)map_sysmem(images.initrd_start, 1));
+	ut_asserteq(0, buf[0]);
+	unmap_sysmem(buf);
+
+	/* that is the kernel and the ramdisk, each copied once */
+	bootstage_report();
+	ut_assert_skip_to_line("Accumulated time:");
+	ut_assert(console_record_readline(line, sizeof(uts->actual_str)) >= 0);
+	ut_assertnonnull(strstr(line, "  image_copy (12288 bytes)"));
+
+	free(gd->bootstage);
+	gd->bootstage = old;
+	ut_assertok(env_set("initrd_high", NULL));
+	ut_assertok(env_set("verify", NULL));
+
+	return 0;
+}
+BOOTSTD_TEST(test_image_ramdisk_bootm, UT_TESTF_CONSOLE_REC);
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for the memory benchmark
+ */
+
+#include <common.h>
+#include <console.h>
+#include <mapmem.h>
+#include <membench.h>
+#include <dm/test.h>
+#include <test/ut.h>
+
+/* Declare a new mem test */
+#define MEM_TEST(_name, _flags)	UNIT_TEST(_name, _flags, mem_test)
+
+/* Test 'membench' */
+static int mem_test_membench(struct unit_test_state *uts)
+{
+	ulong *line, *start;
+	void *buf;
+	int i;
+
+	ut_assertok(console_record_reset_enable());
+	ut_assertok(run_command("membench 1010 4000 1000 2000", 0));
+	ut_assert_nextline("Testing 00001040 ... 00004fff:");
+	ut_assert_nextline("Bandwidth in MB/s (1 CPU):");
+	ut_assert_nextline("Test           C      arch      SIMD");
+	ut_assert_nextlinen("read  ");
+	ut_assert_nextlinen("write ");
+	ut_assert_nextlinen("memset         -  ");
+	ut_assert_nextlinen("memcpy");
+	ut_assert_nextline("Latency in ns per load:");
+	ut_assert_nextline("Working set        ns");
+	ut_assert_nextlinen("       1000  ");
+	ut_assert_nextlinen("       2000  ");
+	ut_assert_console_end();
+
+	/* The lines of the last working set are left in one cycle */
+	buf = map_sysmem(0x1040, 0x2000);
+	start = buf;
+	line = start;
+	for (i = 0; i < 0x2000 / MEMBENCH_LINE; i++) {
+		line = (ulong *)*line;
+		ut_assert((void *)line >= buf && (void *)line < buf + 0x2000);
+		if (line == start)
+			break;
+	}
+	ut_asserteq(0x2000 / MEMBENCH_LINE - 1, i);
+	unmap_sysmem(buf);
+
+	/* The range has to hold two cache lines */
+	ut_asserteq(1, run_command("membench 1010 80", 0));
+	ut_assert_nextline("Range too small");
+	ut_assert_console_end();
+
+	/* The working sets have to fit in the range */
+	ut_asserteq(1, run_command("membench 1000 1000 40 2000", 0));
+	ut_assert_skip_to_line("Usage:");
+
+	return 0;
+}
+MEM_TEST(mem_test_membench, UT_TESTF_CONSOLE_REC);
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for the parallel memory test
+ */
+
+#include <common.h>
+#include <console.h>
+#include <mapmem.h>
+#include <memtest.h>
+#include <dm/test.h>
+#include <test/ut.h>
+
+#define BUF_ADDR	0x1000
+#define BUF_SIZE	0x2000
+
+/* Declare a new mem test */
+#define MEM_TEST(_name, _flags)	UNIT_TEST(_name, _flags, mem_test)
+
+/* Test the engine on parts which fall back to this CPU */
+static int mem_test_memtest_run(struct unit_test_state *uts)
+{
+	struct memtest_part parts[2];
+	void *buf;
+	int i;
+
+	buf = map_sysmem(BUF_ADDR, BUF_SIZE);
+	memset(parts, '\0', sizeof(parts));
+	for (i = 0; i < ARRAY_SIZE(parts); i++) {
+		parts[i].addr = BUF_ADDR + i * BUF_SIZE / 2;
+		parts[i].buf = buf + i * BUF_SIZE / 2;
+		parts[i].size = BUF_SIZE / 2;
+		parts[i].seed = 0x5a5a5a5a;
+	}
+	ut_asserteq(1, memtest_run(parts, ARRAY_SIZE(parts)));
+
+	for (i = 0; i < ARRAY_SIZE(parts); i++) {
+		ut_assert(parts[i].done);
+		ut_asserteq(0, parts[i].errs);
+		ut_asserteq(0, parts[i].nfails);
+		/* 2 for address, 16 for walking ones, 6 for moving inversions */
+		ut_asserteq(24 * BUF_SIZE / 2, parts[i].bytes);
+	}
+
+	/* The moving inversions test leaves the seed behind */
+	ut_asserteq(0x5a5a5a5a, *(u64 *)buf);
+	ut_asserteq(0x5a5a5a5a, *(u64 *)(buf + BUF_SIZE - sizeof(u64)));
+	unmap_sysmem(buf);
+
+	return 0;
+}
+MEM_TEST(mem_test_memtest_run, 0);
+
+/* Test 'mtest -p' */
+static int mem_test_mtest_parallel(struct unit_test_state *uts)
+{
+	u64 *buf;
+
+	ut_assertok(console_record_reset_enable());
+	ut_assertok(run_command("mtest -p 1010 3000 0 2", 0));
+	ut_assert_nextline("Testing 00001010 ... 00003000:");
+	ut_assert_nextline("Iteration:      1");
+	ut_assert_nextline("Iteration:      1 (1 CPU)");
+	ut_assert_nextlinen("Part  Start             End                 Errors      MB/s");
+	ut_assert_nextlinen("   0  0000000000001040  0000000000002fff         0");
+	ut_assert_nextline("Iteration:      2");
+	ut_assert_nextline("Iteration:      2 (1 CPU)");
+	ut_assert_skipline();
+	ut_assert_nextlinen("   0  0000000000001040  0000000000002fff         0");
+	ut_assert_nextline("%s", "");
+	ut_assert_nextline("Tested 2 iteration(s) with 0 errors.");
+	ut_assert_console_end();
+
+	/* The second iteration inverts the pattern */
+	buf = map_sysmem(0x1040, 0x1fc0);
+	ut_asserteq_64(~0ULL, buf[0]);
+	ut_asserteq_64(~0ULL, buf[0x1fc0 / sizeof(u64) - 1]);
+	unmap_sysmem(buf);
+
+	return 0;
+}
+MEM_TEST(mem_test_mtest_parallel, UT_TESTF_CONSOLE_REC);
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Unit tests for the bootstage profiler
+ */
+
+#include <common.h>
+#include <bootstage.h>
+#include <malloc.h>
+#include <asm/global_data.h>
+#include <test/common.h>
+#include <test/test.h>
+#include <test/ut.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/* Record spans in a fresh bootstage table and check the Chrome trace */
+static int bootstage_test_profile(struct unit_test_state *uts)
+{
+	struct bootstage_data *old = gd->bootstage;
+	int outer, inner, last, len;
+	char buf[512];
+
+	/* The boot has likely filled the table, so use a new one */
+	ut_assertok(bootstage_init(true));
+
+	outer = bootstage_span_start_addr(BOOTSTAGE_SPAN_INITCALL, 0x1234);
+	inner = bootstage_span_start(BOOTSTAGE_SPAN_PROBE, "dev\"name");
+	last = bootstage_span_start(BOOTSTAGE_SPAN_POST_PROBE,
+				    "a name which is too long to fit");
+	bootstage_span_end(last);
+	bootstage_span_end(inner);
+	bootstage_span_end(outer);
+	ut_asserteq(0, outer);
+	ut_asserteq(1, inner);
+	ut_asserteq(2, last);
+
+	len = bootstage_profile_chrome(NULL, 0);
+	ut_assert(len > 0 && len < sizeof(buf));
+	ut_asserteq(len, bootstage_profile_chrome(buf, sizeof(buf)));
+	ut_asserteq(len, strlen(buf));
+
+	/* A truncated trace is still terminated */
+	ut_asserteq(len, bootstage_profile_chrome(buf, 10));
+	ut_asserteq(9, strlen(buf));
+	bootstage_profile_chrome(buf, sizeof(buf));
+
+	ut_assertnonnull(strstr(buf, "{\"name\":\"reset\",\"cat\":\"bootstage\",\"ph\":\"i\""));
+	ut_assertnonnull(strstr(buf, "{\"name\":\"1234\",\"cat\":\"initcall\",\"ph\":\"X\""));
+	ut_assertnonnull(strstr(buf, "{\"name\":\"dev\\\"name\",\"cat\":\"probe\""));
+	ut_assertnonnull(strstr(buf, "{\"name\":\"a name which is too \",\"cat\":\"post_probe\""));
+
+	free(gd->bootstage);
+	gd->bootstage = old;
+
+	return 0;
+}
+COMMON_TEST(bootstage_test_profile, 0);
+
+/* Check that spans are dropped, not overrun, once the table is full */
+static int bootstage_test_profile_full(struct unit_test_state *uts)
+{
+	struct bootstage_data *old = gd->bootstage;
+	int span, i;
+
+	ut_assertok(bootstage_init(true));
+
+	for (i = 0; i < CONFIG_BOOTSTAGE_PROFILE_COUNT; i++)
+		bootstage_span_end(bootstage_span_start(BOOTSTAGE_SPAN_PROBE,
+							"fill"));
+	span = bootstage_span_start(BOOTSTAGE_SPAN_PROBE, "lost");
+	ut_asserteq(CONFIG_BOOTSTAGE_PROFILE_COUNT, span);
+	bootstage_span_end(span);
+
+	/* Each further span is counted as lost */
+	span = bootstage_span_start(BOOTSTAGE_SPAN_PROBE, "lost");
+	bootstage_span_end(span);
+
+	console_record_reset_enable();
+	bootstage_profile_report();
+	ut_assert_skip_to_line("Lost 2 spans");
+	ut_assert_nextline("Please increase CONFIG_BOOTSTAGE_PROFILE_COUNT");
+	ut_assert_console_end();
+
+	free(gd->bootstage);
+	gd->bootstage = old;
+
+	return 0;
+}
+COMMON_TEST(bootstage_test_profile_full, UT_TESTF_CONSOLE_REC);
+
+/* Check that the bytes handled by an activity are added up and reported */
+static int bootstage_test_accum_size(struct unit_test_state *uts)
+{
+	struct bootstage_data *old = gd->bootstage;
+	char *line = uts->actual_str;
+
+	ut_assertok(bootstage_init(true));
+
+	bootstage_start(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, "image_copy");
+	bootstage_accum_size(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, 1000);
+	bootstage_start(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, "image_copy");
+	bootstage_accum_size(BOOTSTAGE_ID_ACCUM_IMAGE_COPY, 234);
+
+	console_record_reset_enable();
+	bootstage_report();
+	ut_assert_skip_to_line("Accumulated time:");
+	ut_assert(console_record_readline(line, sizeof(uts->actual_str)) >= 0);
+	ut_assertnonnull(strstr(line, "  image_copy (1234 bytes)"));
+	ut_assert_console_end();
+
+	free(gd->bootstage);
+	gd->bootstage = old;
+
+	return 0;
+}
+COMMON_TEST(bootstage_test_accum_size, UT_TESTF_CONSOLE_REC);
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for command lookup and the hush parse cache
+ */
+
+#include <common.h>
+#include <command.h>
+#include <env.h>
+#include <test/common.h>
+#include <test/test.h>
+#include <test/ut.h>
+
+/* Check that each command is found as a linear search would find it */
+static int cli_test_find_cmd(struct unit_test_state *uts)
+{
+	struct cmd_tbl *start = ll_entry_start(struct cmd_tbl, cmd);
+	const int count = ll_entry_count(struct cmd_tbl, cmd);
+	struct cmd_tbl *cmdtp, *first;
+	char name[40];
+
+	for (cmdtp = start; cmdtp != start + count; cmdtp++) {
+		for (first = start; strcmp(first->name, cmdtp->name); first++)
+			;
+		ut_asserteq_ptr(first, find_cmd(cmdtp->name));
+
+		/* Size suffixes are ignored */
+		snprintf(name, sizeof(name), "%s.b", cmdtp->name);
+		ut_asserteq_ptr(first, find_cmd(name));
+	}
+
+	/* Abbreviations still work, as long as they are unique */
+	ut_asserteq_str("echo", find_cmd("ech")->name);
+	ut_assertnull(find_cmd("e"));
+	ut_assertnull(find_cmd("no-such-command"));
+
+	return 0;
+}
+COMMON_TEST(cli_test_find_cmd, 0);
+
+#ifdef CONFIG_HUSH_PARSE_CACHE
+/* Run the same strings several times, so that they come from the cache */
+static int cli_test_hush_parse_cache(struct unit_test_state *uts)
+{
+	int i;
+
+	ut_assertok(env_set("out", NULL));
+	ut_assertok(env_set("loop",
+			    "for i in a b; do setenv out ${out}${i}; done"));
+	for (i = 0; i < 3; i++)
+		ut_assertok(run_command("run loop", 0));
+	ut_asserteq_str("ababab", env_get("out"));
+
+	ut_assertok(env_set("n", NULL));
+	ut_assertok(env_set("count", "setenv n ${n}x; "
+			    "if test ${n} = xxx; then false; else true; fi"));
+	ut_assertok(run_command("run count", 0));
+	ut_assertok(run_command("run count", 0));
+	ut_asserteq(1, run_command("run count", 0));
+	ut_asserteq_str("xxx", env_get("n"));
+
+	/* A changed variable is parsed again */
+	ut_assertok(env_set("count", "setenv n y"));
+	ut_assertok(run_command("run count", 0));
+	ut_asserteq_str("y", env_get("n"));
+
+	ut_assertok(env_set("out", NULL));
+	ut_assertok(env_set("loop", NULL));
+	ut_assertok(env_set("n", NULL));
+	ut_assertok(env_set("count", NULL));
+
+	return 0;
+}
+COMMON_TEST(cli_test_hush_parse_cache, 0);
+#endif
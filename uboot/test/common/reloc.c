@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Unit tests for running U-Boot without relocating it
+ */
+
+#include <common.h>
+#include <asm/global_data.h>
+#include <test/common.h>
+#include <test/test.h>
+#include <test/ut.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/* Check that only the code stays put with CONFIG_SKIP_RELOCATE */
+static int reloc_test_skip(struct unit_test_state *uts)
+{
+	ut_assert(gd->flags & GD_FLG_SKIP_RELOC);
+
+	/* Data from before relocation still moves to its reserved space */
+	ut_assertnonnull(gd->new_fdt);
+	ut_asserteq_ptr(gd->new_fdt, gd->fdt_blob);
+	ut_assertnonnull(gd->new_bootstage);
+	ut_asserteq_ptr(gd->new_bootstage, gd->bootstage);
+
+	return 0;
+}
+COMMON_TEST(reloc_test_skip, 0);
@@ -14,6 +14,8 @@
 #include <mapmem.h>
 #include <asm/io.h>
 
+#include <u-boot/crc.h>
+
 #include <u-boot/lz4.h>
 #include <u-boot/zlib.h>
 #include <bzlib.h>
@@ -508,6 +510,102 @@ static int compression_test_zstd(struct unit_test_state *uts)
 }
 COMPRESSION_TEST(compression_test_zstd, 0);
 
+#define MATCH_TEST_SIZE		(64 << 10)
+
+/*
+ * Build a buffer made of runs which repeat with every period from 1 to 40
+ * bytes, separated by pseudo-random literals, so that the inflate fast path
+ * sees both short overlapping matches and long word-sized copies, from the
+ * output buffer as well as from the sliding window.
+ */
+static void fill_match_pattern(u8 *buf, ulong size)
+{
+	uint lfsr = 0xace1;
+	uint period = 1;
+	ulong i = 0;
+
+	while (i < size) {
+		uint run = 3 + (lfsr % 300);
+		uint j;
+
+		for (j = 0; j < period && i < size; j++, i++) {
+			lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xb400);
+			buf[i] = lfsr;
+		}
+		for (j = 0; j < run && i < size; j++, i++)
+			buf[i] = buf[i - period];
+		period = period % 40 + 1;
+	}
+}
+
+static int compression_test_gzip_matches(struct unit_test_state *uts)
+{
+	ulong comp_size, out_size;
+	u8 *orig, *comp, *out;
+
+	orig = malloc(MATCH_TEST_SIZE);
+	comp = malloc(MATCH_TEST_SIZE);
+	out = malloc(MATCH_TEST_SIZE + 1);
+	ut_assertnonnull(orig);
+	ut_assertnonnull(comp);
+	ut_assertnonnull(out);
+
+	fill_match_pattern(orig, MATCH_TEST_SIZE);
+	comp_size = MATCH_TEST_SIZE;
+	ut_assertok(gzip(comp, &comp_size, orig, MATCH_TEST_SIZE));
+	ut_assert(comp_size < MATCH_TEST_SIZE);
+
+	memset(out, 'A', MATCH_TEST_SIZE + 1);
+	out_size = comp_size;
+	ut_assertok(gunzip(out, MATCH_TEST_SIZE, comp, &out_size));
+	ut_asserteq_mem(orig, out, MATCH_TEST_SIZE);
+	ut_asserteq('A', out[MATCH_TEST_SIZE]);
+
+	free(out);
+	free(comp);
+	free(orig);
+
+	return 0;
+}
+COMPRESSION_TEST(compression_test_gzip_matches, 0);
+
+/* Bit-at-a-time reference implementation of crc32_no_comp() */
+static u32 crc32_no_comp_ref(u32 crc, const u8 *buf, uint len)
+{
+	int i;
+
+	while (len--) {
+		crc ^= *buf++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (-(crc & 1) & 0xedb88320);
+	}
+
+	return crc;
+}
+
+static int compression_test_crc32(struct unit_test_state *uts)
+{
+	uint align, len;
+	u8 buf[300 + 8];
+
+	fill_match_pattern(buf, sizeof(buf));
+
+	/* "123456789" is the standard check input for CRC-32 */
+	ut_asserteq(0xcbf43926, crc32(0, (const u8 *)"123456789", 9));
+
+	for (align = 0; align < 8; align++) {
+		for (len = 0; len <= 300; len++) {
+			ut_asserteq(crc32_no_comp_ref(0x12345678, buf + align,
+						      len),
+				    crc32_no_comp(0x12345678, buf + align,
+						  len));
+		}
+	}
+
+	return 0;
+}
+COMPRESSION_TEST(compression_test_crc32, 0);
+
 static int compress_using_none(struct unit_test_state *uts,
 			       void *in, unsigned long in_size,
 			       void *out, unsigned long out_max,
@@ -5,6 +5,7 @@
 
 #include <common.h>
 #include <dm.h>
+#include <memalign.h>
 #include <part.h>
 #include <sandbox_host.h>
 #include <usb.h>
@@ -337,3 +338,39 @@ static int dm_test_blk_foreach(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_blk_foreach, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+
+/* Test that transfers the DMA cannot reach go through the bounce buffer */
+static int dm_test_blk_dma_bounce(struct unit_test_state *uts)
+{
+	ALLOC_CACHE_ALIGN_BUFFER(char, write, 1024 + ARCH_DMA_MINALIGN);
+	ALLOC_CACHE_ALIGN_BUFFER(char, read, 1024 + ARCH_DMA_MINALIGN);
+	struct blk_desc *desc;
+	int i;
+
+	ut_assertok(blk_get_device_by_str("mmc", "0", &desc));
+	ut_asserteq(512, desc->blksz);
+	ut_assert(!blk_dma_bounces(desc));
+	blk_set_dma_limits(desc, ARCH_DMA_MINALIGN, 0);
+	ut_assert(blk_dma_bounces(desc));
+
+	for (i = 0; i < 1024 + ARCH_DMA_MINALIGN; i++)
+		write[i] = i;
+
+	/* Misaligned buffers are bounced */
+	ut_asserteq(2, blk_dwrite(desc, 0, 2, write + 1));
+	ut_asserteq(2, blk_dread(desc, 0, 2, read + 3));
+	ut_asserteq_mem(write + 1, read + 3, 1024);
+	ut_asserteq(2, desc->bounces);
+	ut_asserteq(2048, desc->bounce_bytes);
+
+	/* Aligned ones go straight to the device */
+	ut_asserteq(2, blk_dwrite(desc, 2, 2, write));
+	ut_asserteq(2, blk_dread(desc, 2, 2, read));
+	ut_asserteq_mem(write, read, 1024);
+	ut_asserteq(2, desc->bounces);
+
+	blk_set_dma_limits(desc, 0, 0);
+
+	return 0;
+}
+DM_TEST(dm_test_blk_dma_bounce, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
@@ -13,6 +13,7 @@
 #include <malloc.h>
 #include <asm/global_data.h>
 #include <dm/device-internal.h>
+#include <dm/lists.h>
 #include <dm/root.h>
 #include <dm/util.h>
 #include <dm/test.h>
@@ -1353,3 +1354,93 @@ static int dm_test_dev_get_mem(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_dev_get_mem, UT_TESTF_SCAN_FDT);
+
+/* Test that looking up a driver by compatible string picks the first match */
+static int dm_test_lookup_compat(struct unit_test_state *uts)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+	const int n_ents = ll_entry_count(struct driver, driver);
+	const struct udevice_id *of_match, *id, *expect_id;
+	struct driver *drv, *entry, *expect;
+
+	for (drv = driver; drv != driver + n_ents; drv++) {
+		for (of_match = drv->of_match;
+		     of_match && of_match->compatible; of_match++) {
+			/* Find the first driver using this string */
+			expect = NULL;
+			expect_id = NULL;
+			for (entry = driver; !expect; entry++) {
+				for (id = entry->of_match;
+				     id && id->compatible; id++) {
+					if (!strcmp(id->compatible,
+						    of_match->compatible)) {
+						expect = entry;
+						expect_id = id;
+						break;
+					}
+				}
+			}
+
+			id = NULL;
+			entry = lists_driver_lookup_compat(of_match->compatible,
+							   &id);
+			ut_asserteq_ptr(expect, entry);
+			ut_asserteq_ptr(expect_id, id);
+		}
+	}
+
+	ut_assertnull(lists_driver_lookup_compat("denx,u-boot-no-such-device",
+						 &id));
+	ut_assertnull(lists_driver_lookup_compat("", &id));
+
+	return 0;
+}
+DM_TEST(dm_test_lookup_compat, 0);
+
+/* Test that deferred nodes are bound when first looked up */
+static int dm_test_lazy_bind(struct unit_test_state *uts)
+{
+	struct udevice *dev, *bus;
+	struct uclass *uc;
+	ofnode node;
+
+	if (!CONFIG_IS_ENABLED(DM_LAZY_BIND))
+		return -EAGAIN;
+
+	/* This bus has 'u-boot,lazy-bind', so nothing in it is bound yet */
+	node = ofnode_path("/lazy-bind-test");
+	ut_assert(ofnode_valid(node));
+	device_foreach_child(dev, uts->root)
+		ut_assert(!ofnode_equal(dev_ofnode(dev), node));
+	uc = uclass_find(UCLASS_TEST_DUMMY);
+	ut_assertnonnull(uc);
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+	ut_assert(!list_empty(&uc->lazy_head));
+#endif
+
+	/* Looking up a uclass binds the subtree holding its devices */
+	ut_assertok(uclass_find_device_by_name(UCLASS_TEST_DUMMY, "lazy-dev",
+					       &dev));
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+	ut_assert(list_empty(&uc->lazy_head));
+#endif
+	bus = dev_get_parent(dev);
+	ut_asserteq_str("lazy-bind-test", bus->name);
+	ut_asserteq(1, device_get_child_count(bus));
+
+	/* Sound has DM_UC_FLAG_LAZY_BIND */
+	uc = uclass_find(UCLASS_SOUND);
+	ut_assert(!uc || list_empty(&uc->dev_head));
+	ut_assertok(uclass_find_first_device(UCLASS_SOUND, &dev));
+	ut_assertnonnull(dev);
+
+	/* Looking up a node binds it */
+	node = ofnode_path("/panel");
+	uc = uclass_find(UCLASS_PANEL);
+	ut_assert(!uc || list_empty(&uc->dev_head));
+	ut_assertok(device_find_global_by_ofnode(node, &dev));
+	ut_asserteq_str("panel", dev->name);
+
+	return 0;
+}
+DM_TEST(dm_test_lazy_bind, UT_TESTF_SCAN_FDT);
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for the hash uclass
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <image.h>
+#include <dm/test.h>
+#include <test/ut.h>
+#include <u-boot/hash.h>
+#include <u-boot/sha256.h>
+#include <u-boot/sha512.h>
+
+/* SHA-256 of "abc", from FIPS 180-2 */
+static const u8 sha256_abc[SHA256_SUM_LEN] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+	0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+	0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+/* Test that the fastest device is picked for each algorithm */
+static int dm_test_hash_get_device(struct unit_test_state *uts)
+{
+	struct udevice *dev;
+
+	ut_assertok(hash_get_device(HASH_ALGO_SHA256, &dev));
+	ut_asserteq_str("hash", dev->name);
+	ut_assert(device_active(dev));
+
+	ut_assertok(hash_get_device(HASH_ALGO_SHA1, &dev));
+	ut_asserteq_str("hash", dev->name);
+
+	/* only the software driver has SHA-512 */
+	ut_assertok(hash_get_device(HASH_ALGO_SHA512, &dev));
+	ut_asserteq_str("hash_sw", dev->name);
+
+	ut_asserteq(-EINVAL, hash_get_device(HASH_ALGO_NUM, &dev));
+
+	return 0;
+}
+DM_TEST(dm_test_hash_get_device, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+
+/* Test that an asynchronous digest is only valid after waiting */
+static int dm_test_hash_digest_async(struct unit_test_state *uts)
+{
+	u8 obuf[SHA256_SUM_LEN], zero[SHA256_SUM_LEN] = { };
+	struct udevice *dev;
+	void *req;
+
+	ut_assertok(hash_get_device(HASH_ALGO_SHA256, &dev));
+
+	memset(obuf, '\0', sizeof(obuf));
+	ut_assertok(hash_digest_start(dev, HASH_ALGO_SHA256, "abc", 3, obuf,
+				      &req));
+	ut_assertnonnull(req);
+	ut_asserteq_mem(zero, obuf, sizeof(obuf));
+	ut_assertok(hash_digest_wait(dev, req));
+	ut_asserteq_mem(sha256_abc, obuf, sizeof(obuf));
+
+	/* unsupported algorithms are refused when starting */
+	ut_asserteq(-EPROTONOSUPPORT,
+		    hash_digest_start(dev, HASH_ALGO_SHA512, "abc", 3, obuf,
+				      &req));
+
+	return 0;
+}
+DM_TEST(dm_test_hash_digest_async, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+
+/* Test the synchronous fallback for devices without a queue */
+static int dm_test_hash_digest_sync(struct unit_test_state *uts)
+{
+	u8 obuf[SHA512_SUM_LEN], expect[SHA512_SUM_LEN];
+	struct udevice *dev;
+	void *req;
+
+	ut_assertok(hash_get_device(HASH_ALGO_SHA512, &dev));
+	sha512_csum_wd((const u8 *)"abc", 3, expect, CHUNKSZ_SHA512);
+
+	memset(obuf, '\0', sizeof(obuf));
+	ut_assertok(hash_digest_start(dev, HASH_ALGO_SHA512, "abc", 3, obuf,
+				      &req));
+	ut_assertnull(req);
+	ut_asserteq_mem(expect, obuf, sizeof(obuf));
+	ut_assertok(hash_digest_wait(dev, req));
+
+	return 0;
+}
+DM_TEST(dm_test_hash_digest_sync, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+
+/* Test that FIT image hashes are checked on the hash engine */
+static int dm_test_hash_fit_batch(struct unit_test_state *uts)
+{
+	u8 value[SHA256_SUM_LEN];
+	int images, node, hash;
+	char fit[1024];
+
+	ut_assertok(fdt_create_empty_tree(fit, sizeof(fit)));
+	images = fdt_add_subnode(fit, 0, "images");
+	ut_assert(images >= 0);
+	node = fdt_add_subnode(fit, images, "script-1");
+	ut_assert(node >= 0);
+	ut_assertok(fdt_setprop(fit, node, FIT_DATA_PROP, "abc", 3));
+	hash = fdt_add_subnode(fit, node, "hash-1");
+	ut_assert(hash >= 0);
+	ut_assertok(fdt_setprop_string(fit, hash, FIT_ALGO_PROP, "sha256"));
+	ut_assertok(fdt_setprop(fit, hash, FIT_VALUE_PROP, sha256_abc,
+				sizeof(sha256_abc)));
+	ut_asserteq(1, fit_all_image_verify(fit));
+
+	/* a wrong digest is still caught */
+	memcpy(value, sha256_abc, sizeof(value));
+	value[0] ^= 1;
+	hash = fdt_path_offset(fit, "/images/script-1/hash-1");
+	ut_assertok(fdt_setprop_inplace(fit, hash, FIT_VALUE_PROP, value,
+					sizeof(value)));
+	ut_asserteq(0, fit_all_image_verify(fit));
+
+	return 0;
+}
+DM_TEST(dm_test_hash_fit_batch, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
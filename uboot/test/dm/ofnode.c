@@ -23,6 +23,7 @@
 #include <dm/device-internal.h>
 #include <dm/lists.h>
 #include <dm/of_extra.h>
+#include <dm/of_lookup.h>
 #include <dm/root.h>
 #include <dm/test.h>
 #include <dm/uclass-internal.h>
@@ -1040,6 +1041,57 @@ static int dm_test_ofnode_add_subnode(struct unit_test_state *uts)
 }
 DM_TEST(dm_test_ofnode_add_subnode, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
 
+/* Check that each node below @parent is found by its path and phandle */
+static int check_lookup(struct unit_test_state *uts, ofnode parent)
+{
+	char path[256];
+	ofnode node;
+	u32 phandle;
+
+	ofnode_for_each_subnode(node, parent) {
+		ut_assertok(ofnode_get_path(node, path, sizeof(path)));
+		ut_assert(ofnode_equal(node, ofnode_path(path)));
+		if (!ofnode_read_u32(node, "phandle", &phandle))
+			ut_assert(ofnode_equal(node,
+					       ofnode_get_by_phandle(phandle)));
+		ut_assertok(check_lookup(uts, node));
+	}
+
+	return 0;
+}
+
+static int dm_test_ofnode_lookup(struct unit_test_state *uts)
+{
+	ofnode node, subnode, aliases;
+
+	ut_assertok(check_lookup(uts, ofnode_root()));
+	node = ofnode_path("/i2c@0");
+	ut_assert(ofnode_valid(node));
+	ut_assert(ofnode_equal(node, ofnode_path("i2c0")));
+
+	if (CONFIG_IS_ENABLED(OF_LOOKUP_CACHE)) {
+		ut_assert(ofnode_equal(node, of_lookup_path("/i2c@0")));
+		ut_assert(ofnode_equal(node, of_lookup_path("i2c0")));
+		ut_assert(!ofnode_valid(of_lookup_path("/i2c@0/nothing")));
+
+		/* An alias found in the table must still refer to the node */
+		aliases = ofnode_path("/aliases");
+		ut_assertok(ofnode_write_string(aliases, "i2c0", "/spi@0"));
+		ut_assert(!ofnode_valid(of_lookup_path("i2c0")));
+		ut_assertok(ofnode_write_string(aliases, "i2c0", "/i2c@0"));
+		ut_assert(ofnode_equal(node, of_lookup_path("i2c0")));
+	}
+
+	/* Adding a node moves the nodes after it in a flat tree */
+	ut_assertok(ofnode_add_subnode(ofnode_path("/lcd"), "lookup",
+				       &subnode));
+	ut_assert(ofnode_equal(subnode, ofnode_path("/lcd/lookup")));
+	ut_assertok(check_lookup(uts, ofnode_root()));
+
+	return 0;
+}
+DM_TEST(dm_test_ofnode_lookup, UT_TESTF_SCAN_FDT);
+
 static int dm_test_ofnode_for_each_prop(struct unit_test_state *uts)
 {
 	ofnode node, subnode;
@@ -6,6 +6,8 @@
 
 #include <common.h>
 #include <command.h>
+#include <env_flags.h>
+#include <image.h>
 #include <log.h>
 #include <search.h>
 #include <stdio.h>
@@ -124,3 +126,86 @@ static int env_test_htab_deletes(struct unit_test_state *uts)
 }
 
 ENV_TEST(env_test_htab_deletes, 0);
+
+#ifdef CONFIG_ENV_BULK_IMPORT
+#define BULK_ENV \
+	"loadaddr=1234\0" \
+	"ipaddr=nonsense\0" \
+	"eth5addr=nonsense\0" \
+	".flags=bulk_n:d\0" \
+	"bulk_n=ten\0" \
+	"bulk_a=1\0" \
+	"bulk_b=1\0" \
+	"bulk_a=2\0" \
+	"bulk_b\0"
+
+static const char htab_bulk_env[] = BULK_ENV "\0" "bulk_c=3";
+
+static int htab_check_item(struct unit_test_state *uts,
+			   struct hsearch_data *htab, const char *key,
+			   const char *data)
+{
+	struct env_entry item;
+	struct env_entry *ritem;
+
+	item.key = key;
+	item.data = NULL;
+	hsearch_r(item, ENV_FIND, &ritem, htab, 0);
+	if (!data) {
+		ut_assertnull(ritem);
+		return 0;
+	}
+	ut_assertnonnull(ritem);
+	ut_asserteq_str(data, ritem->data);
+
+	return 0;
+}
+
+/* Import a whole environment in bulk, then change it */
+static int env_test_htab_bulk(struct unit_test_state *uts)
+{
+	ulong load_addr = image_load_addr;
+	struct hsearch_data htab;
+	struct env_entry item;
+	struct env_entry *ritem;
+
+	memset(&htab, 0, sizeof(htab));
+	htab.change_ok = env_flags_validate;
+	ut_asserteq(1, himport_r(&htab, htab_bulk_env, sizeof(htab_bulk_env),
+				 '\0', 0, 0, 0, NULL));
+
+	/* Only the used part of the text is kept */
+	ut_asserteq(sizeof(BULK_ENV), htab.pool_size);
+
+	/* Variables are checked and their callbacks run */
+	ut_asserteq(0x1234, image_load_addr);
+	image_load_addr = load_addr;
+	ut_assertok(htab_check_item(uts, &htab, "ipaddr", NULL));
+	ut_assertok(htab_check_item(uts, &htab, "bulk_n", NULL));
+	if (IS_ENABLED(CONFIG_REGEX))
+		ut_assertok(htab_check_item(uts, &htab, "eth5addr", NULL));
+
+	/* Later entries win */
+	ut_assertok(htab_check_item(uts, &htab, "bulk_a", "2"));
+	ut_assertok(htab_check_item(uts, &htab, "bulk_b", NULL));
+	ut_assertok(htab_check_item(uts, &htab, "bulk_c", NULL));
+
+	/* The variables can be changed and deleted */
+	item.callback = NULL;
+	item.flags = 0;
+	item.key = "bulk_a";
+	item.data = "3";
+	ut_assert(hsearch_r(item, ENV_ENTER, &ritem, &htab, 0));
+	ut_assertok(htab_check_item(uts, &htab, "bulk_a", "3"));
+	ut_assertok(hdelete_r("bulk_a", &htab, 0));
+	ut_assertok(hdelete_r(".flags", &htab, 0));
+	ut_assertok(htab_check_item(uts, &htab, "bulk_a", NULL));
+
+	hdestroy_r(&htab);
+	ut_assertnull(htab.pool);
+
+	return 0;
+}
+
+ENV_TEST(env_test_htab_bulk, 0);
+#endif
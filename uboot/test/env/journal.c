@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for the environment journal
+ */
+
+#include <common.h>
+#include <blk.h>
+#include <env.h>
+#include <env_internal.h>
+#include <malloc.h>
+#include <memalign.h>
+#include <asm/global_data.h>
+#include <test/env.h>
+#include <test/ut.h>
+#include <u-boot/crc.h>
+
+#define BLKSZ	512
+#define NBLKS	4
+
+static void env_test_journal_free(struct env_journal *jnl)
+{
+	free(jnl->snap);
+	free(jnl->next);
+}
+
+static int env_test_journal(struct unit_test_state *uts)
+{
+	struct env_journal jnl, replay;
+	struct env_journal_rec *rec;
+	char *buf;
+	env_t *env;
+	int i;
+
+	env = malloc(sizeof(*env));
+	ut_assertnonnull(env);
+	buf = calloc(NBLKS, BLKSZ);
+	ut_assertnonnull(buf);
+	memset(&jnl, '\0', sizeof(jnl));
+	jnl.blksz = BLKSZ;
+	jnl.size = NBLKS * BLKSZ;
+
+	/* Start a journal for the current environment */
+	env_set("jnl_a", NULL);
+	env_set("jnl_b", NULL);
+	ut_assertok(env_export(env));
+	ut_asserteq(BLKSZ, env_journal_start(&jnl, env, buf));
+	env_journal_commit(&jnl);
+	ut_asserteq(BLKSZ, jnl.end);
+
+	/* Each change takes a record */
+	ut_assertok(env_set("jnl_a", "1"));
+	ut_asserteq(BLKSZ, env_journal_append(&jnl, buf + jnl.end));
+	rec = (void *)buf + jnl.end;
+	ut_asserteq(sizeof("jnl_a=1"), rec->len);
+	ut_asserteq_mem("jnl_a=1", rec->data, rec->len);
+	env_journal_commit(&jnl);
+
+	ut_assertok(env_set("jnl_a", NULL));
+	ut_assertok(env_set("jnl_b", "2"));
+	ut_asserteq(BLKSZ, env_journal_append(&jnl, buf + jnl.end));
+	rec = (void *)buf + jnl.end;
+	ut_asserteq(sizeof("jnl_a\0jnl_b=2"), rec->len);
+	ut_asserteq_mem("jnl_a\0jnl_b=2", rec->data, rec->len);
+	env_journal_commit(&jnl);
+
+	/* Nothing is written if nothing changed */
+	ut_asserteq(0, env_journal_append(&jnl, buf + jnl.end));
+
+	/* Going back to the environment copy, the records bring it up to date */
+	ut_assertok(env_set("jnl_a", "x"));
+	ut_assertok(env_set("jnl_b", NULL));
+	memset(&replay, '\0', sizeof(replay));
+	replay.blksz = BLKSZ;
+	replay.size = NBLKS * BLKSZ;
+	ut_asserteq(2, env_journal_replay(&replay, buf, env->crc, 0));
+	ut_assertnull(env_get("jnl_a"));
+	ut_asserteq_str("2", env_get("jnl_b"));
+	ut_asserteq(jnl.end, replay.end);
+	ut_asserteq(jnl.seq, replay.seq);
+	ut_asserteq(0, env_journal_append(&replay, buf + replay.end));
+
+	/* The journal is ignored if it was started for another copy */
+	ut_asserteq(-ENOENT, env_journal_replay(&replay, buf, ~env->crc, 0));
+	ut_assert(!replay.valid);
+
+	/* A bad record ends the journal */
+	buf[2 * BLKSZ + sizeof(*rec)] ^= 1;
+	ut_assertok(env_set("jnl_b", NULL));
+	ut_asserteq(1, env_journal_replay(&replay, buf, env->crc, 0));
+	ut_asserteq_str("1", env_get("jnl_a"));
+	ut_assertnull(env_get("jnl_b"));
+	ut_asserteq(2 * BLKSZ, replay.end);
+
+	/* A full journal asks for the whole environment to be written */
+	for (i = 0; i < NBLKS - 2; i++) {
+		ut_assertok(env_set_ulong("jnl_a", i));
+		ut_asserteq(BLKSZ, env_journal_append(&replay,
+						      buf + replay.end));
+		env_journal_commit(&replay);
+	}
+	ut_asserteq(NBLKS * BLKSZ, replay.end);
+	ut_assertok(env_set("jnl_a", NULL));
+	ut_asserteq(-ENOSPC, env_journal_append(&replay, buf + replay.end));
+
+	env_test_journal_free(&replay);
+	env_test_journal_free(&jnl);
+	free(buf);
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_journal, 0);
+
+#ifdef CONFIG_ENV_IS_IN_MMC
+DECLARE_GLOBAL_DATA_PTR;
+
+/*
+ * Get the MMC location directly, so that it need not be one the board
+ * loads from
+ */
+static struct env_driver *env_test_journal_mmc_drv(void)
+{
+	struct env_driver *drv = ll_entry_start(struct env_driver, env_driver);
+	const int n_ents = ll_entry_count(struct env_driver, env_driver);
+	struct env_driver *entry;
+
+	for (entry = drv; entry != drv + n_ents; entry++) {
+		if (entry->location == ENVL_MMC)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/* Check that the copy on mmc0 is valid and whether it holds @var */
+static int env_test_journal_copy(struct unit_test_state *uts, env_t *env,
+				 const char *var)
+{
+	struct blk_desc *desc;
+	lbaint_t cnt;
+	char *p;
+
+	desc = blk_get_devnum_by_uclass_id(UCLASS_MMC, 0);
+	ut_assertnonnull(desc);
+	cnt = CONFIG_ENV_SIZE / desc->blksz;
+	ut_asserteq(cnt, blk_dread(desc, CONFIG_ENV_OFFSET / desc->blksz, cnt,
+				   env));
+	ut_asserteq(env->crc, crc32(0, env->data, ENV_SIZE));
+
+	for (p = (char *)env->data; *p; p += strlen(p) + 1) {
+		if (!strcmp(p, var))
+			return 1;
+	}
+
+	return 0;
+}
+
+/* Test the journal of the MMC location, through its driver */
+static int env_test_journal_mmc(struct unit_test_state *uts)
+{
+	int old_valid = gd->env_valid;
+	struct env_driver *drv;
+	struct blk_desc *desc;
+	char var[32];
+	env_t *env;
+	int i;
+
+	drv = env_test_journal_mmc_drv();
+	ut_assertnonnull(drv);
+	env = malloc_cache_aligned(sizeof(*env));
+	ut_assertnonnull(env);
+
+	/* After erasing, the first save writes the copy and starts the journal */
+	ut_assertok(drv->erase());
+	ut_assertok(env_set("jnl_mmc", NULL));
+	ut_assertok(drv->save());
+	ut_asserteq(0, env_test_journal_copy(uts, env, "jnl_mmc=1"));
+
+	/* A change only goes to the journal, but loading picks it up */
+	ut_assertok(env_set("jnl_mmc", "1"));
+	ut_assertok(drv->save());
+	ut_asserteq(0, env_test_journal_copy(uts, env, "jnl_mmc=1"));
+	ut_assertok(env_set("jnl_mmc", NULL));
+	ut_assertok(drv->load());
+	ut_asserteq_str("1", env_get("jnl_mmc"));
+
+	/*
+	 * Each save takes a block after the one starting the journal, and the
+	 * copy is only written again once the journal is full
+	 */
+	desc = blk_get_devnum_by_uclass_id(UCLASS_MMC, 0);
+	ut_assertnonnull(desc);
+	for (i = 2; i <= CONFIG_ENV_JOURNAL_SIZE / desc->blksz; i++) {
+		snprintf(var, sizeof(var), "jnl_mmc=%d", i);
+		ut_assertok(env_set_ulong("jnl_mmc", i));
+		ut_assertok(drv->save());
+		ut_asserteq(i == CONFIG_ENV_JOURNAL_SIZE / desc->blksz,
+			    env_test_journal_copy(uts, env, var));
+	}
+
+	/* That started a new journal */
+	ut_assertok(env_set("jnl_mmc", "1"));
+	ut_assertok(drv->save());
+	ut_asserteq(1, env_test_journal_copy(uts, env, var));
+	ut_assertok(drv->load());
+	ut_asserteq_str("1", env_get("jnl_mmc"));
+
+	ut_assertok(env_set("jnl_mmc", NULL));
+	gd->env_valid = old_valid;
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_journal_mmc, 0);
+#endif
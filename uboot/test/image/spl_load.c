@@ -10,6 +10,7 @@
 #include <os.h>
 #include <spl.h>
 #include <test/ut.h>
+#include <u-boot/sha256.h>
 
 /* Declare a new SPL test */
 #define SPL_TEST(_name, _flags)		UNIT_TEST(_name, _flags, spl_test)
@@ -89,3 +90,106 @@ static int spl_test_load(struct unit_test_state *uts)
 	return 0;
 }
 SPL_TEST(spl_test_load, 0);
+
+#if CONFIG_IS_ENABLED(FIT_STREAM_HASH)
+/* FIT with one external image, used by spl_test_stream_hash */
+#define TEST_FIT_DATA_POS	0x400
+#define TEST_FIT_LOAD		0x200000
+
+static ulong read_mem(struct spl_load_info *load, ulong sector, ulong count,
+		      void *buf)
+{
+	memcpy(buf, load->priv + sector * load->bl_len, count * load->bl_len);
+
+	return count;
+}
+
+static int make_test_fit(struct unit_test_state *uts, void *fit, int size,
+			 const char *data, int *nodep)
+{
+	u8 value[SHA256_SUM_LEN];
+	int images, node, hash, confs, conf;
+
+	sha256_csum_wd((const u8 *)"abc", 3, value, CHUNKSZ_SHA256);
+
+	ut_assertok(fdt_create_empty_tree(fit, TEST_FIT_DATA_POS));
+	images = fdt_add_subnode(fit, 0, "images");
+	ut_assert(images >= 0);
+	node = fdt_add_subnode(fit, images, "firmware-1");
+	ut_assert(node >= 0);
+	ut_assertok(fdt_setprop_string(fit, node, FIT_TYPE_PROP, "firmware"));
+	ut_assertok(fdt_setprop_string(fit, node, FIT_OS_PROP,
+				       "arm-trusted-firmware"));
+	ut_assertok(fdt_setprop_u32(fit, node, FIT_LOAD_PROP, TEST_FIT_LOAD));
+	ut_assertok(fdt_setprop_u32(fit, node, FIT_DATA_POSITION_PROP,
+				    TEST_FIT_DATA_POS));
+	ut_assertok(fdt_setprop_u32(fit, node, FIT_DATA_SIZE_PROP, 3));
+	hash = fdt_add_subnode(fit, node, "hash-1");
+	ut_assert(hash >= 0);
+	ut_assertok(fdt_setprop_string(fit, hash, FIT_ALGO_PROP, "sha256"));
+	ut_assertok(fdt_setprop(fit, hash, FIT_VALUE_PROP, value,
+				sizeof(value)));
+
+	confs = fdt_add_subnode(fit, 0, "configurations");
+	ut_assert(confs >= 0);
+	ut_assertok(fdt_setprop_string(fit, confs, FIT_DEFAULT_PROP,
+				       "conf-1"));
+	conf = fdt_add_subnode(fit, confs, "conf-1");
+	ut_assert(conf >= 0);
+	ut_assertok(fdt_setprop_string(fit, conf, FIT_DESC_PROP, "test"));
+	ut_assertok(fdt_setprop_string(fit, conf, FIT_FIRMWARE_PROP,
+				       "firmware-1"));
+	ut_assertok(fdt_pack(fit));
+
+	memset(fit + TEST_FIT_DATA_POS, '\0', size - TEST_FIT_DATA_POS);
+	memcpy(fit + TEST_FIT_DATA_POS, data, 3);
+	*nodep = fdt_path_offset(fit, "/images/firmware-1");
+	ut_assert(*nodep >= 0);
+
+	return 0;
+}
+
+/* Test that a digest from an earlier streamed read is not used later */
+static int spl_test_stream_hash(struct unit_test_state *uts)
+{
+	u8 value[SHA256_SUM_LEN];
+	struct spl_image_info image;
+	struct spl_load_info load;
+	char fit[0x800];
+	int node;
+
+	memset(&load, '\0', sizeof(load));
+	load.read = read_mem;
+	load.priv = fit;
+
+	/* streamed (raw) read of a good image */
+	ut_assertok(make_test_fit(uts, fit, sizeof(fit), "abc", &node));
+	load.bl_len = 512;
+	memset(&image, '\0', sizeof(image));
+	ut_assertok(spl_load_simple_fit(&image, &load, 0, fit));
+	ut_asserteq(TEST_FIT_LOAD, image.load_addr);
+
+	/*
+	 * A streamed read of the good image left its digest behind without
+	 * it being checked, then the loader fails over to a file read of a
+	 * corrupted copy into the same place
+	 */
+	sha256_csum_wd((const u8 *)"abc", 3, value, CHUNKSZ_SHA256);
+	fit_image_set_hash(fit, node, map_sysmem(TEST_FIT_LOAD, 3), 3,
+			   "sha256", value, sizeof(value));
+	ut_assertok(make_test_fit(uts, fit, sizeof(fit), "abd", &node));
+	load.bl_len = 1;
+	load.filename = "fit";
+	ut_asserteq(-EPERM, spl_load_simple_fit(&image, &load, 0, fit));
+
+	/* a raw read hashes the corrupted copy itself */
+	fit_image_set_hash(fit, node, map_sysmem(TEST_FIT_LOAD, 3), 3,
+			   "sha256", value, sizeof(value));
+	load.bl_len = 512;
+	load.filename = NULL;
+	ut_asserteq(-EPERM, spl_load_simple_fit(&image, &load, 0, fit));
+
+	return 0;
+}
+SPL_TEST(spl_test_stream_hash, 0);
+#endif
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Unit tests for saving and restoring DDR PHY training results
+ */
+
+#include <common.h>
+#include <ddrphy_qb_cache.h>
+#include <errno.h>
+#include <test/lib.h>
+#include <test/ut.h>
+
+/* A few trained CSR addresses, as in an i.MX8M dram timing file */
+static const u32 fake_csr_addr[] = {
+	0x200b2, 0x1200b2, 0x200cb, 0x10043, 0x110043, 0x10143, 0x11043,
+	0x12043, 0x13043, 0x1005f, 0x1015f, 0x1105f, 0x1205f, 0x1305f,
+};
+
+#define FAKE_NUM_CSR	ARRAY_SIZE(fake_csr_addr)
+#define FAKE_KEY	0x12345678
+
+/* Value the fake training leaves in CSR @idx */
+#define FAKE_TRAINED(idx)	((u16)(fake_csr_addr[idx] ^ ((idx) * 0x111)))
+
+/* Fake APB register file of the PHY */
+static u16 fake_apb[FAKE_NUM_CSR];
+static int fake_writes;
+
+static u16 fake_read_csr(int idx)
+{
+	return fake_apb[idx];
+}
+
+static void fake_write_csr(int idx, u16 val)
+{
+	fake_apb[idx] = val;
+	fake_writes++;
+}
+
+static const struct ddrphy_qb_cache_ops fake_ops = {
+	.num_csr = FAKE_NUM_CSR,
+	.read_csr = fake_read_csr,
+	.write_csr = fake_write_csr,
+};
+
+/* Fill the PHY as a training would, then save the results into @buf */
+static int fake_train_and_save(struct unit_test_state *uts, void *buf,
+			       size_t size, const u32 *extra)
+{
+	int i;
+
+	for (i = 0; i < FAKE_NUM_CSR; i++)
+		fake_apb[i] = FAKE_TRAINED(i);
+	ut_asserteq(ddrphy_qb_cache_size(FAKE_NUM_CSR),
+		    ddrphy_qb_cache_save(&fake_ops, FAKE_KEY, extra, buf,
+					 size));
+
+	/* the PHY comes up cleared on the next boot */
+	memset(fake_apb, '\0', sizeof(fake_apb));
+	fake_writes = 0;
+
+	return 0;
+}
+
+static int fake_check_trained(struct unit_test_state *uts)
+{
+	int i;
+
+	for (i = 0; i < FAKE_NUM_CSR; i++)
+		ut_asserteq(FAKE_TRAINED(i), fake_apb[i]);
+
+	return 0;
+}
+
+static int fake_check_untouched(struct unit_test_state *uts)
+{
+	int i;
+
+	ut_asserteq(0, fake_writes);
+	for (i = 0; i < FAKE_NUM_CSR; i++)
+		ut_asserteq(0, fake_apb[i]);
+
+	return 0;
+}
+
+/* Test restoring saved training results */
+static int lib_ddrphy_qb_restore(struct unit_test_state *uts)
+{
+	u32 extra[DDRPHY_QB_CACHE_EXTRA], out[DDRPHY_QB_CACHE_EXTRA];
+	char buf[256] __aligned(4);
+	int i;
+
+	for (i = 0; i < DDRPHY_QB_CACHE_EXTRA; i++)
+		extra[i] = i + 1;
+	ut_assertok(fake_train_and_save(uts, buf, sizeof(buf), extra));
+
+	ut_assertok(ddrphy_qb_cache_check(&fake_ops, FAKE_KEY, buf,
+					  sizeof(buf)));
+	ut_asserteq(ddrphy_qb_cache_size(FAKE_NUM_CSR),
+		    ddrphy_qb_cache_saved_size(buf, sizeof(buf)));
+	ut_assertok(fake_check_untouched(uts));
+
+	memset(out, '\0', sizeof(out));
+	ut_assertok(ddrphy_qb_cache_restore(&fake_ops, FAKE_KEY, buf,
+					    sizeof(buf), out));
+	ut_asserteq(FAKE_NUM_CSR, fake_writes);
+	ut_assertok(fake_check_trained(uts));
+	ut_asserteq_mem(extra, out, sizeof(extra));
+
+	/* the saved size is enough */
+	memset(fake_apb, '\0', sizeof(fake_apb));
+	ut_assertok(ddrphy_qb_cache_restore(&fake_ops, FAKE_KEY, buf,
+					    ddrphy_qb_cache_size(FAKE_NUM_CSR),
+					    NULL));
+	ut_assertok(fake_check_trained(uts));
+
+	return 0;
+}
+LIB_TEST(lib_ddrphy_qb_restore, 0);
+
+/* Test that unusable training results leave the PHY alone */
+static int lib_ddrphy_qb_bad(struct unit_test_state *uts)
+{
+	struct ddrphy_qb_cache_ops ops = fake_ops;
+	struct ddrphy_qb_cache_hdr *hdr;
+	char buf[256] __aligned(4);
+
+	hdr = (struct ddrphy_qb_cache_hdr *)buf;
+	ut_asserteq(-ENOSPC, ddrphy_qb_cache_save(&fake_ops, FAKE_KEY, NULL,
+						  buf, sizeof(*hdr)));
+
+	/* corrupted CSR value */
+	ut_assertok(fake_train_and_save(uts, buf, sizeof(buf), NULL));
+	buf[sizeof(*hdr) + 3] ^= 0x40;
+	ut_asserteq(-EBADMSG, ddrphy_qb_cache_restore(&fake_ops, FAKE_KEY, buf,
+						      sizeof(buf), NULL));
+	ut_asserteq(-EBADMSG, ddrphy_qb_cache_saved_size(buf, sizeof(buf)));
+	ut_assertok(fake_check_untouched(uts));
+
+	/* corrupted key */
+	ut_assertok(fake_train_and_save(uts, buf, sizeof(buf), NULL));
+	hdr->key ^= 1;
+	ut_asserteq(-EBADMSG, ddrphy_qb_cache_restore(&fake_ops, FAKE_KEY ^ 1,
+						      buf, sizeof(buf), NULL));
+	ut_assertok(fake_check_untouched(uts));
+
+	/* trained with another DRAM timing */
+	ut_assertok(fake_train_and_save(uts, buf, sizeof(buf), NULL));
+	ut_asserteq(-ESTALE, ddrphy_qb_cache_restore(&fake_ops, FAKE_KEY + 1,
+						     buf, sizeof(buf), NULL));
+	ut_assertok(fake_check_untouched(uts));
+
+	/* truncated */
+	ut_asserteq(-EINVAL, ddrphy_qb_cache_restore(&fake_ops, FAKE_KEY, buf,
+						     sizeof(*hdr), NULL));
+
+	/* saved for a different set of CSRs */
+	ops.num_csr--;
+	ut_asserteq(-EINVAL, ddrphy_qb_cache_restore(&ops, FAKE_KEY, buf,
+						     sizeof(buf), NULL));
+	ut_assertok(fake_check_untouched(uts));
+
+	ut_asserteq(-EINVAL, ddrphy_qb_cache_saved_size(buf, sizeof(*hdr)));
+
+	/* nothing saved */
+	memset(buf, '\xff', sizeof(buf));
+	ut_asserteq(-ENOENT, ddrphy_qb_cache_saved_size(buf, sizeof(buf)));
+	ut_asserteq(-ENOENT, ddrphy_qb_cache_check(&fake_ops, FAKE_KEY, buf,
+						   sizeof(buf)));
+	ut_asserteq(-ENOENT, ddrphy_qb_cache_check(&fake_ops, FAKE_KEY, buf,
+						   sizeof(*hdr) - 1));
+
+	return 0;
+}
+LIB_TEST(lib_ddrphy_qb_bad, 0);
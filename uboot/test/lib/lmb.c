@@ -732,10 +732,90 @@ static int lib_test_lmb_max_regions(struct unit_test_state *uts)
 
 	return 0;
 }
-#endif
 
 DM_TEST(lib_test_lmb_max_regions,
 	UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+#endif
+
+#ifdef CONFIG_LMB_DYNAMIC
+/* Check that the region lists grow and stay sorted with many regions */
+static int lib_test_lmb_many_regions(struct unit_test_state *uts)
+{
+	const phys_addr_t ram = 0x40000000;
+	const phys_size_t ram_size = 0x20000000;
+	const phys_size_t blk_size = 0x1000;
+	const int count = 1000;
+	const phys_size_t bank_size = 0x100000;
+	const int banks = 64;
+	phys_addr_t addr;
+	struct lmb lmb;
+	long ret;
+	int i, k;
+
+	lmb_init(&lmb);
+	ut_asserteq(CONFIG_LMB_RESERVED_REGIONS, lmb.reserved.max);
+	ut_asserteq(0, lmb_add(&lmb, ram, ram_size));
+
+	/* Reserve every other block, in an order which inserts in the middle */
+	for (i = 0; i < count; i++) {
+		k = (i * 397) % count;
+		ret = lmb_reserve(&lmb, ram + 2 * k * blk_size, blk_size);
+		ut_asserteq(0, ret);
+	}
+	ut_asserteq(count, lmb.reserved.cnt);
+	ut_assert(lmb.reserved.max >= count);
+	for (i = 0; i < count; i++) {
+		ut_asserteq(ram + 2 * i * blk_size, lmb.reserved.region[i].base);
+		ut_asserteq(blk_size, lmb.reserved.region[i].size);
+	}
+	ut_asserteq(1, lmb_is_reserved(&lmb, ram + 20 * blk_size));
+	ut_asserteq(0, lmb_is_reserved(&lmb, ram + 21 * blk_size));
+	ut_asserteq(blk_size, lmb_get_free_size(&lmb, ram + 21 * blk_size));
+	ut_asserteq(0, lmb_get_free_size(&lmb, ram + 22 * blk_size));
+
+	/* Fill the gaps, which merges everything into one region */
+	for (i = 0; i < count - 1; i++) {
+		k = (i * 397) % (count - 1);
+		ret = lmb_reserve(&lmb, ram + (2 * k + 1) * blk_size, blk_size);
+		ut_assert(ret > 0);
+	}
+	ASSERT_LMB(&lmb, ram, ram_size, 1, ram, (2 * count - 1) * blk_size,
+		   0, 0, 0, 0);
+
+	/* Punch the holes out again */
+	for (i = 0; i < count - 1; i++) {
+		k = (i * 397) % (count - 1);
+		ret = lmb_free(&lmb, ram + (2 * k + 1) * blk_size, blk_size);
+		ut_asserteq(0, ret);
+	}
+	ut_asserteq(count, lmb.reserved.cnt);
+	for (i = 0; i < count; i++)
+		ut_asserteq(ram + 2 * i * blk_size, lmb.reserved.region[i].base);
+
+	lmb_uninit(&lmb);
+	ut_asserteq(0, lmb.reserved.cnt);
+	ut_asserteq(CONFIG_LMB_RESERVED_REGIONS, lmb.reserved.max);
+
+	/* Allocate from many memory banks, top down */
+	for (i = 0; i < banks; i++) {
+		ret = lmb_add(&lmb, ram + 2 * i * bank_size, bank_size);
+		ut_asserteq(0, ret);
+	}
+	ut_asserteq(banks, lmb.memory.cnt);
+	for (i = banks - 1; i >= 0; i--) {
+		addr = lmb_alloc(&lmb, bank_size, bank_size);
+		ut_asserteq(ram + 2 * i * bank_size, addr);
+	}
+	ut_asserteq(0, lmb_alloc(&lmb, blk_size, blk_size));
+	ut_asserteq(banks, lmb.reserved.cnt);
+	lmb_uninit(&lmb);
+
+	return 0;
+}
+
+DM_TEST(lib_test_lmb_many_regions,
+	UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+#endif
 
 static int lib_test_lmb_flags(struct unit_test_state *uts)
 {
@@ -203,4 +203,52 @@ static int lib_rsa_verify_invalid(struct unit_test_state *uts)
 }
 
 LIB_TEST(lib_rsa_verify_invalid, 0);
+
+/**
+ * lib_rsa_verify_cached() - unit test for the RSA key cache
+ *
+ * Test rsa_verify() repeatedly with the same key, which is parsed only once
+ *
+ * @uts:	unit test state
+ * Return:	0 = success, 1 = failure
+ */
+static int lib_rsa_verify_cached(struct unit_test_state *uts)
+{
+	struct image_sign_info info;
+	struct image_region reg;
+	unsigned char ctmp;
+	int ret;
+
+	memset(&info, '\0', sizeof(info));
+	info.name = "sha256,rsa2048";
+	info.padding = image_get_padding_algo("pkcs-1.5");
+	info.checksum = image_get_checksum_algo("sha256,rsa2048");
+	info.crypto = image_get_crypto_algo(info.name);
+
+	info.key = public_key;
+	info.keylen = public_key_len;
+
+	reg.data = data_raw;
+	reg.size = data_raw_len;
+
+	rsa_key_cache_flush();
+	ut_assertok(rsa_verify(&info, &reg, 1, data_enc, data_enc_len));
+	ut_assertok(rsa_verify(&info, &reg, 1, data_enc, data_enc_len));
+
+	/* A cached key must still reject a bad signature */
+	ctmp = data_enc[data_enc_len - 10];
+	data_enc[data_enc_len - 10] = 0x12;
+	ret = rsa_verify(&info, &reg, 1, data_enc, data_enc_len);
+	data_enc[data_enc_len - 10] = ctmp;
+	ut_assert(ret != 0);
+
+	/* Both calls shared a single entry */
+	if (IS_ENABLED(CONFIG_RSA_KEY_CACHE))
+		ut_asserteq(1, rsa_key_cache_flush());
+	ut_asserteq(0, rsa_key_cache_flush());
+
+	return CMD_RET_SUCCESS;
+}
+
+LIB_TEST(lib_rsa_verify_cached, 0);
 #endif /* RSA_VERIFY_WITH_PKEY */
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Unit tests for SHA-256 multi-buffer hashing and SHA-384/SHA-512
+ *
+ * Test vectors are from FIPS 180-2.
+ */
+
+#include <common.h>
+#include <test/lib.h>
+#include <test/ut.h>
+#include <u-boot/sha256.h>
+#include <u-boot/sha512.h>
+
+static const char msg_abc[] = "abc";
+static const char msg_448[] =
+	"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static const char __maybe_unused msg_896[] =
+	"abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+	"hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+static const u8 sha256_empty[SHA256_SUM_LEN] = {
+	0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14,
+	0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+	0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c,
+	0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55,
+};
+
+static const u8 sha256_abc[SHA256_SUM_LEN] = {
+	0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+	0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+	0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+	0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+};
+
+static const u8 sha256_448[SHA256_SUM_LEN] = {
+	0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8,
+	0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+	0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+	0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+};
+
+static void fill_pattern(u8 *buf, int len)
+{
+	u32 x = 0x12345678;
+	int i;
+
+	for (i = 0; i < len; i++) {
+		x = x * 1103515245 + 12345;
+		buf[i] = x >> 16;
+	}
+}
+
+/* Test sha256_csum_mb() against known digests */
+static int lib_test_sha256_mb(struct unit_test_state *uts)
+{
+	u8 out[3][SHA256_SUM_LEN];
+	struct sha256_mb_job jobs[] = {
+		{ (const u8 *)msg_abc, strlen(msg_abc), out[0] },
+		{ (const u8 *)msg_448, strlen(msg_448), out[1] },
+		{ (const u8 *)"", 0, out[2] },
+	};
+
+	sha256_csum_mb(jobs, ARRAY_SIZE(jobs));
+	ut_asserteq_mem(sha256_abc, out[0], SHA256_SUM_LEN);
+	ut_asserteq_mem(sha256_448, out[1], SHA256_SUM_LEN);
+	ut_asserteq_mem(sha256_empty, out[2], SHA256_SUM_LEN);
+
+	return 0;
+}
+LIB_TEST(lib_test_sha256_mb, 0);
+
+/* Test that pairs of any lengths match sha256_csum_wd() */
+static int lib_test_sha256_mb_lengths(struct unit_test_state *uts)
+{
+	static u8 buf[1024];
+	u8 out[2][SHA256_SUM_LEN], expect[2][SHA256_SUM_LEN];
+	struct sha256_mb_job jobs[2];
+	int len0, len1;
+
+	fill_pattern(buf, sizeof(buf));
+	for (len0 = 0; len0 <= 300; len0 += 13) {
+		for (len1 = 0; len1 <= 700; len1 += 61) {
+			jobs[0].input = buf;
+			jobs[0].ilen = len0;
+			jobs[0].output = out[0];
+			jobs[1].input = buf + 3;
+			jobs[1].ilen = len1;
+			jobs[1].output = out[1];
+			sha256_csum_mb(jobs, 2);
+
+			sha256_csum_wd(buf, len0, expect[0], CHUNKSZ_SHA256);
+			sha256_csum_wd(buf + 3, len1, expect[1],
+				       CHUNKSZ_SHA256);
+			ut_asserteq_mem(expect[0], out[0], SHA256_SUM_LEN);
+			ut_asserteq_mem(expect[1], out[1], SHA256_SUM_LEN);
+		}
+	}
+
+	return 0;
+}
+LIB_TEST(lib_test_sha256_mb_lengths, 0);
+
+#if CONFIG_IS_ENABLED(SHA512)
+static const u8 sha512_abc[SHA512_SUM_LEN] = {
+	0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba,
+	0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+	0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2,
+	0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+	0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8,
+	0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+	0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e,
+	0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f,
+};
+
+static const u8 sha512_896[SHA512_SUM_LEN] = {
+	0x8e, 0x95, 0x9b, 0x75, 0xda, 0xe3, 0x13, 0xda,
+	0x8c, 0xf4, 0xf7, 0x28, 0x14, 0xfc, 0x14, 0x3f,
+	0x8f, 0x77, 0x79, 0xc6, 0xeb, 0x9f, 0x7f, 0xa1,
+	0x72, 0x99, 0xae, 0xad, 0xb6, 0x88, 0x90, 0x18,
+	0x50, 0x1d, 0x28, 0x9e, 0x49, 0x00, 0xf7, 0xe4,
+	0x33, 0x1b, 0x99, 0xde, 0xc4, 0xb5, 0x43, 0x3a,
+	0xc7, 0xd3, 0x29, 0xee, 0xb6, 0xdd, 0x26, 0x54,
+	0x5e, 0x96, 0xe5, 0x5b, 0x87, 0x4b, 0xe9, 0x09,
+};
+
+/* Test SHA-512 against known digests, in one go and in pieces */
+static int lib_test_sha512(struct unit_test_state *uts)
+{
+	u8 out[SHA512_SUM_LEN];
+	sha512_context ctx;
+	int i;
+
+	sha512_csum_wd((const u8 *)msg_abc, strlen(msg_abc), out,
+		       CHUNKSZ_SHA512);
+	ut_asserteq_mem(sha512_abc, out, SHA512_SUM_LEN);
+
+	sha512_csum_wd((const u8 *)msg_896, strlen(msg_896), out,
+		       CHUNKSZ_SHA512);
+	ut_asserteq_mem(sha512_896, out, SHA512_SUM_LEN);
+
+	/* odd-sized updates cross the block boundary at every offset */
+	sha512_starts(&ctx);
+	for (i = 0; i < strlen(msg_896); i += 7)
+		sha512_update(&ctx, (const u8 *)msg_896 + i,
+			      min(7, (int)strlen(msg_896) - i));
+	sha512_finish(&ctx, out);
+	ut_asserteq_mem(sha512_896, out, SHA512_SUM_LEN);
+
+	return 0;
+}
+LIB_TEST(lib_test_sha512, 0);
+#endif
+
+#if CONFIG_IS_ENABLED(SHA384)
+static const u8 sha384_abc[SHA384_SUM_LEN] = {
+	0xcb, 0x00, 0x75, 0x3f, 0x45, 0xa3, 0x5e, 0x8b,
+	0xb5, 0xa0, 0x3d, 0x69, 0x9a, 0xc6, 0x50, 0x07,
+	0x27, 0x2c, 0x32, 0xab, 0x0e, 0xde, 0xd1, 0x63,
+	0x1a, 0x8b, 0x60, 0x5a, 0x43, 0xff, 0x5b, 0xed,
+	0x80, 0x86, 0x07, 0x2b, 0xa1, 0xe7, 0xcc, 0x23,
+	0x58, 0xba, 0xec, 0xa1, 0x34, 0xc8, 0x25, 0xa7,
+};
+
+static const u8 sha384_896[SHA384_SUM_LEN] = {
+	0x09, 0x33, 0x0c, 0x33, 0xf7, 0x11, 0x47, 0xe8,
+	0x3d, 0x19, 0x2f, 0xc7, 0x82, 0xcd, 0x1b, 0x47,
+	0x53, 0x11, 0x1b, 0x17, 0x3b, 0x3b, 0x05, 0xd2,
+	0x2f, 0xa0, 0x80, 0x86, 0xe3, 0xb0, 0xf7, 0x12,
+	0xfc, 0xc7, 0xc7, 0x1a, 0x55, 0x7e, 0x2d, 0xb9,
+	0x66, 0xc3, 0xe9, 0xfa, 0x91, 0x74, 0x60, 0x39,
+};
+
+/* Test SHA-384 against known digests */
+static int lib_test_sha384(struct unit_test_state *uts)
+{
+	u8 out[SHA384_SUM_LEN];
+
+	sha384_csum_wd((const u8 *)msg_abc, strlen(msg_abc), out,
+		       CHUNKSZ_SHA384);
+	ut_asserteq_mem(sha384_abc, out, SHA384_SUM_LEN);
+
+	sha384_csum_wd((const u8 *)msg_896, strlen(msg_896), out,
+		       CHUNKSZ_SHA384);
+	ut_asserteq_mem(sha384_896, out, SHA384_SUM_LEN);
+
+	return 0;
+}
+LIB_TEST(lib_test_sha384, 0);
+#endif
@@ -100,6 +100,20 @@ struct env_image_redundant {
 	char data[];
 };
 
+#ifdef CONFIG_ENV_JOURNAL
+/* Record of the journal U-Boot keeps after each copy, see env_internal.h */
+#define ENV_JOURNAL_MAGIC	0x4c4e524a	/* "JRNL" */
+
+struct env_journal_rec {
+	uint32_t magic;
+	uint32_t crc;		/* CRC32 of the fields below and the data */
+	uint32_t prev;		/* crc of the previous record or the copy */
+	uint32_t seq;
+	uint32_t len;		/* bytes of data */
+	char data[];		/* "name=value" or "name" to delete */
+};
+#endif
+
 enum flag_scheme {
 	FLAG_NONE,
 	FLAG_BOOLEAN,
@@ -505,6 +519,118 @@ int fw_printenv(int argc, char *argv[], int value_only, struct env_opts *opts)
 	return rc;
 }
 
+#ifdef CONFIG_ENV_JOURNAL
+static int env_journal_blksz(int fd)
+{
+	int blksz;
+
+	if (ioctl(fd, BLKSSZGET, &blksz) || blksz <= 0)
+		blksz = 512;
+
+	return blksz;
+}
+
+/*
+ * Apply the records of the journal which follows the environment copy of
+ * device @dev, as U-Boot does when loading it. Only block devices, or files
+ * holding their image, have a journal.
+ */
+static int env_journal_replay(int dev)
+{
+	const size_t size = CONFIG_ENV_JOURNAL_SIZE;
+	struct env_journal_rec *rec;
+	uint32_t prev = *environment.crc;
+	uint32_t seq = 0;
+	size_t off = 0;
+	char *buf, *name, *val;
+	int fd, blksz, rc = 0;
+
+	if (DEVTYPE(dev) != MTD_ABSENT || IS_UBI(dev))
+		return 0;
+
+	buf = malloc(size);
+	if (!buf) {
+		fprintf(stderr, "Not enough memory for environment journal\n");
+		return -1;
+	}
+	fd = open(DEVNAME(dev), O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "Can't open %s: %s\n", DEVNAME(dev),
+			strerror(errno));
+		free(buf);
+		return -1;
+	}
+	blksz = env_journal_blksz(fd);
+	if (pread(fd, buf, size, DEVOFFSET(dev) + ENVSIZE(dev)) != size)
+		memset(buf, '\0', size);	/* no journal */
+	close(fd);
+
+	while (off + sizeof(*rec) <= size) {
+		rec = (struct env_journal_rec *)(buf + off);
+		if (rec->magic != ENV_JOURNAL_MAGIC ||
+		    rec->len > size - off - sizeof(*rec) ||
+		    rec->crc != crc32(0, (uint8_t *)&rec->prev,
+				      sizeof(*rec) -
+				      offsetof(struct env_journal_rec, prev) +
+				      rec->len) ||
+		    rec->prev != prev || (off && rec->seq != seq + 1))
+			break;
+
+		/* The first record holds no data */
+		for (name = rec->data; name < rec->data + rec->len;
+		     name += strlen(name) + 1) {
+			val = strchr(name, '=');
+			if (val)
+				*val++ = '\0';
+			rc = fw_env_write(name, val);
+			if (rc)
+				goto out;
+			if (val)
+				name = val;
+		}
+		seq = rec->seq;
+		prev = rec->crc;
+		off += DIV_ROUND_UP(sizeof(*rec) + rec->len, blksz) * blksz;
+	}
+out:
+	free(buf);
+
+	return rc;
+}
+
+/*
+ * Clear the start of the journal which follows the copy of device @dev, so
+ * that U-Boot does not apply it to the copy just written
+ */
+static int env_journal_clear(int dev)
+{
+	char *buf;
+	int fd, blksz, rc = 0;
+
+	if (DEVTYPE(dev) != MTD_ABSENT || IS_UBI(dev))
+		return 0;
+
+	fd = open(DEVNAME(dev), O_RDWR);
+	if (fd < 0) {
+		fprintf(stderr, "Can't open %s: %s\n", DEVNAME(dev),
+			strerror(errno));
+		return -1;
+	}
+	blksz = env_journal_blksz(fd);
+	buf = calloc(1, blksz);
+	if (!buf || pwrite(fd, buf, blksz, DEVOFFSET(dev) + ENVSIZE(dev)) !=
+		    blksz || fsync(fd)) {
+		fprintf(stderr, "Can't clear environment journal on %s\n",
+			DEVNAME(dev));
+		rc = -1;
+	}
+	free(buf);
+	close(fd);
+
+	return rc;
+}
+#endif
+
 int fw_env_flush(struct env_opts *opts)
 {
 	if (!opts)
@@ -524,6 +650,12 @@ int fw_env_flush(struct env_opts *opts)
 		return -1;
 	}
 
+#ifdef CONFIG_ENV_JOURNAL
+	/* The copy written holds what the journal did */
+	if (env_journal_clear(have_redund_env ? !dev_current : dev_current))
+		return -1;
+#endif
+
 	return 0;
 }
 
@@ -1418,7 +1550,7 @@ int fw_env_open(struct env_opts *opts)
 	unsigned char flag0;
 	void *addr0 = NULL;
 
-	int crc1, crc1_ok;
+	int crc1, crc1_ok = 0;
 	unsigned char flag1;
 	void *addr1 = NULL;
 
@@ -1587,6 +1719,15 @@ int fw_env_open(struct env_opts *opts)
 		fprintf(stderr, "Selected env in %s\n", DEVNAME(dev_current));
 #endif
 	}
+
+#ifdef CONFIG_ENV_JOURNAL
+	/* The default environment has no journal */
+	if ((dev_current ? crc1_ok : crc0_ok) &&
+	    env_journal_replay(dev_current)) {
+		fw_env_close(opts);
+		return -EIO;
+	}
+#endif
 	return 0;
 
  open_cleanup: